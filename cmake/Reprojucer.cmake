@@ -1,4 +1,4 @@
-# Copyright (C) 2016-2023  Alain Martin
+# Copyright (C) 2016-2023, 2026  Alain Martin
 # Copyright (C) 2017 Matthieu Talbot
 # Copyright (C) 2018-2019 Scott Wheeler
 # Copyright (C) 2022  Thiébaud Fuchs
@@ -118,13 +118,27 @@ function(jucer_project_settings)
     "PROJECT_TYPE"
     "BUNDLE_IDENTIFIER"
     "BINARYDATACPP_SIZE_LIMIT"
+    "BINARYDATACPP_SHARDS"
     "INCLUDE_BINARYDATA"
     "BINARYDATA_NAMESPACE"
+    "GENERATE_BINARYDATA_AT_BUILD_TIME"
+    "CACHE_BINARYDATA"
+    "BINARYDATA_BACKEND"
+    "BINARYDATA_ALIGNMENT"
+    "COMPRESS_BINARYDATA"
+    "DEDUPLICATE_BINARYDATA"
+    "BINARYDATA_LOOKUP"
+    "BINARYDATA_CONSTEXPR_INDEX"
+    "BINARYDATA_CONTENT_HASHES"
     "CXX_LANGUAGE_STANDARD"
     "POST_EXPORT_SHELL_COMMAND_MACOS_LINUX"
     "POST_EXPORT_SHELL_COMMAND_WINDOWS"
   )
-  set(multi_value_keywords "PREPROCESSOR_DEFINITIONS" "HEADER_SEARCH_PATHS")
+  set(multi_value_keywords
+    "PREDECODE_BINARYDATA_IMAGES"
+    "PREPROCESSOR_DEFINITIONS"
+    "HEADER_SEARCH_PATHS"
+  )
 
   _FRUT_parse_arguments("${single_value_keywords}" "${multi_value_keywords}" "${ARGN}")
 
@@ -170,6 +184,58 @@ function(jucer_project_settings)
     list(GET size_limits ${size_limit_index} _BINARYDATACPP_SIZE_LIMIT)
   endif()
 
+  if(DEFINED _BINARYDATACPP_SHARDS)
+    if(_BINARYDATACPP_SHARDS STREQUAL "auto")
+      cmake_host_system_information(RESULT _BINARYDATACPP_SHARDS
+        QUERY NUMBER_OF_LOGICAL_CORES
+      )
+    elseif(NOT _BINARYDATACPP_SHARDS MATCHES "^[1-9][0-9]*$")
+      message(FATAL_ERROR "Unsupported value for BINARYDATACPP_SHARDS:"
+        " \"${_BINARYDATACPP_SHARDS}\"\nSupported values: a positive number, \"auto\""
+      )
+    endif()
+    if(DEFINED _BINARYDATA_BACKEND AND NOT _BINARYDATA_BACKEND STREQUAL "literals")
+      message(FATAL_ERROR "BINARYDATACPP_SHARDS is only supported by the \"literals\""
+        " BINARYDATA_BACKEND"
+      )
+    endif()
+  endif()
+
+  if(DEFINED _BINARYDATA_BACKEND)
+    set(binarydata_backends "literals" "incbin" "elf" "pack")
+    if(NOT _BINARYDATA_BACKEND IN_LIST binarydata_backends)
+      message(FATAL_ERROR "Unsupported value for BINARYDATA_BACKEND:"
+        " \"${_BINARYDATA_BACKEND}\"\nSupported values: ${binarydata_backends}"
+      )
+    endif()
+    if(_BINARYDATA_BACKEND STREQUAL "incbin" AND MSVC)
+      message(FATAL_ERROR "BINARYDATA_BACKEND \"incbin\" is not supported by MSVC")
+    endif()
+    if(_BINARYDATA_BACKEND STREQUAL "elf" AND NOT CMAKE_SYSTEM_NAME STREQUAL "Linux")
+      message(FATAL_ERROR "BINARYDATA_BACKEND \"elf\" is only supported on Linux")
+    endif()
+  endif()
+
+  if(DEFINED _BINARYDATA_ALIGNMENT)
+    set(binarydata_alignments "1" "2" "4" "8" "16" "32" "64" "128" "256" "512" "1024"
+      "2048" "4096"
+    )
+    if(NOT _BINARYDATA_ALIGNMENT IN_LIST binarydata_alignments)
+      message(FATAL_ERROR "Unsupported value for BINARYDATA_ALIGNMENT:"
+        " \"${_BINARYDATA_ALIGNMENT}\"\nSupported values: ${binarydata_alignments}"
+      )
+    endif()
+  endif()
+
+  if(DEFINED _BINARYDATA_LOOKUP)
+    set(binarydata_lookups "switch" "perfect-hash")
+    if(NOT _BINARYDATA_LOOKUP IN_LIST binarydata_lookups)
+      message(FATAL_ERROR "Unsupported value for BINARYDATA_LOOKUP:"
+        " \"${_BINARYDATA_LOOKUP}\"\nSupported values: ${binarydata_lookups}"
+      )
+    endif()
+  endif()
+
   if(DEFINED _CXX_LANGUAGE_STANDARD)
     set(cxx_lang_standard_descs "C++11" "C++14" "C++17" "C++20" "Use Latest")
     set(cxx_lang_standards "11" "14" "17" "20" "latest")
@@ -2430,19 +2496,30 @@ function(jucer_project_end)
   _FRUT_generate_AppConfig_and_JucePluginDefines_header()
   _FRUT_generate_JuceHeader_header()
 
+  # All the icon files and the xcassets folder are generated by a single IconBuilder run
+  set(icon_outputs "")
   if(DEFINED JUCER_SMALL_ICON OR DEFINED JUCER_LARGE_ICON)
-    unset(icon_filename)
     if(APPLE)
-      _FRUT_generate_icon_file("icns" "${CMAKE_CURRENT_BINARY_DIR}" icon_filename)
+      list(APPEND icon_outputs "icns")
     elseif(WIN32 AND NOT JUCER_PROJECT_TYPE STREQUAL "Static Library")
-      _FRUT_generate_icon_file("ico" "${CMAKE_CURRENT_BINARY_DIR}" icon_filename)
+      list(APPEND icon_outputs "ico")
     endif()
+  endif()
+  if(IOS AND (NOT DEFINED JUCER_CUSTOM_XCASSETS_FOLDER
+      OR JUCER_CUSTOM_XCASSETS_FOLDER STREQUAL ""))
+    list(APPEND icon_outputs "xcassets")
+  endif()
 
-    if(DEFINED icon_filename)
-      set(JUCER_ICON_FILE "${CMAKE_CURRENT_BINARY_DIR}/${icon_filename}")
-      if(NOT APPLE) # handled in _FRUT_add_bundle_resources()
-        source_group("JUCE Library Code" FILES "${JUCER_ICON_FILE}")
-      endif()
+  unset(icon_filename)
+  unset(generated_xcassets)
+  if(NOT icon_outputs STREQUAL "")
+    _FRUT_generate_icon_assets("${icon_outputs}" icon_filename generated_xcassets)
+  endif()
+
+  if(DEFINED icon_filename)
+    set(JUCER_ICON_FILE "${CMAKE_CURRENT_BINARY_DIR}/${icon_filename}")
+    if(NOT APPLE) # handled in _FRUT_add_bundle_resources()
+      source_group("JUCE Library Code" FILES "${JUCER_ICON_FILE}")
     endif()
   endif()
 
@@ -2455,7 +2532,7 @@ function(jucer_project_end)
   if(IOS)
     if(NOT DEFINED JUCER_CUSTOM_XCASSETS_FOLDER
         OR JUCER_CUSTOM_XCASSETS_FOLDER STREQUAL "")
-      _FRUT_create_xcassets_folder_from_icons(JUCER_XCASSETS)
+      set(JUCER_XCASSETS "${generated_xcassets}")
     else()
       set(JUCER_XCASSETS "${JUCER_CUSTOM_XCASSETS_FOLDER}")
     endif()
@@ -3232,6 +3309,19 @@ function(jucer_project_end)
 
   endif()
 
+  _FRUT_generate_custom_plist_files()
+
+  if(DEFINED binary_data_job)
+    if(JUCER_PROJECT_TYPE STREQUAL "Audio Plug-in")
+      set(binary_data_target "${target}_Shared_Code")
+    else()
+      set(binary_data_target "${target}")
+    endif()
+    set_property(GLOBAL PROPERTY
+      FRUT_BINARYDATA_JOB_${binary_data_job}_TARGET "${binary_data_target}"
+    )
+  endif()
+
   if(WIN32)
     set(user_cmd "${JUCER_POST_EXPORT_SHELL_COMMAND_WINDOWS}")
   else()
@@ -3264,6 +3354,58 @@ function(jucer_project_end)
 endfunction()
 
 
+function(jucer_generate_binarydata)
+
+  if(NOT ARGC EQUAL 0)
+    message(FATAL_ERROR "jucer_generate_binarydata() doesn't take any argument")
+  endif()
+
+  get_property(num_jobs GLOBAL PROPERTY FRUT_BINARYDATA_NUM_JOBS)
+  if(NOT num_jobs)
+    return()
+  endif()
+
+  _FRUT_build_and_install_tool("BinaryDataBuilder" "0.25.0")
+
+  # The arguments are passed in a file, since the command line of all the projects could
+  # exceed the maximum length of a command line
+  get_property(manifest GLOBAL PROPERTY FRUT_BINARYDATA_MANIFEST)
+  set(manifest_file "${CMAKE_BINARY_DIR}/BinaryData.manifest")
+  file(WRITE "${manifest_file}" "${manifest}")
+
+  message(STATUS "Generating the BinaryData files of ${num_jobs} JUCE projects")
+  execute_process(
+    COMMAND "${BinaryDataBuilder_exe}" "--manifest=${manifest_file}"
+    RESULT_VARIABLE BinaryDataBuilder_return_code
+  )
+  if(NOT BinaryDataBuilder_return_code EQUAL 0)
+    message(FATAL_ERROR "Error when executing BinaryDataBuilder")
+  endif()
+
+  math(EXPR last_job "${num_jobs} - 1")
+  foreach(job RANGE ${last_job})
+    get_property(binary_data_dir GLOBAL PROPERTY FRUT_BINARYDATA_JOB_${job}_DIR)
+    get_property(binary_data_target GLOBAL PROPERTY FRUT_BINARYDATA_JOB_${job}_TARGET)
+    if(NOT binary_data_target)
+      message(FATAL_ERROR "You must call jucer_project_end() before calling"
+        " jucer_generate_binarydata()."
+      )
+    endif()
+
+    file(READ "${binary_data_dir}/BinaryData.files" binary_data_filenames)
+    set(binary_data_files "")
+    foreach(filename IN LISTS binary_data_filenames)
+      list(APPEND binary_data_files "${binary_data_dir}/${filename}")
+    endforeach()
+    target_sources(${binary_data_target} PRIVATE ${binary_data_files})
+  endforeach()
+
+  set_property(GLOBAL PROPERTY FRUT_BINARYDATA_NUM_JOBS 0)
+  set_property(GLOBAL PROPERTY FRUT_BINARYDATA_MANIFEST "")
+
+endfunction()
+
+
 function(_FRUT_abs_path_based_on_jucer_project_dir out_path in_path)
 
   if(NOT IS_ABSOLUTE "${in_path}" AND NOT DEFINED JUCER_PROJECT_DIR)
@@ -3316,6 +3458,11 @@ function(_FRUT_add_bundle_resources target)
   if(IOS)
     list(APPEND bundle_resources ${JUCER_XCASSETS} ${JUCER_LAUNCH_STORYBOARD_FILE})
   endif()
+  # The code generated with BINARYDATA_BACKEND "pack" reads BinaryData.pack from the
+  # Resources folder of the bundle, so that the bundle can be signed
+  if(DEFINED binary_data_pack_file)
+    list(APPEND bundle_resources "${binary_data_pack_file}")
+  endif()
 
   target_sources(${target} PRIVATE ${bundle_resources})
   set_source_files_properties(${bundle_resources} PROPERTIES
@@ -3328,6 +3475,21 @@ endfunction()
 
 function(_FRUT_add_extra_commands target exporter)
 
+  # The code generated with BINARYDATA_BACKEND "pack" reads BinaryData.pack from the
+  # directory of the executable or plugin binary, except in macOS bundles where it is
+  # added to the Resources folder by _FRUT_add_bundle_resources()
+  get_target_property(target_type ${target} TYPE)
+  get_target_property(is_app_bundle ${target} MACOSX_BUNDLE)
+  get_target_property(is_bundle ${target} BUNDLE)
+  if(DEFINED binary_data_pack_file AND NOT target_type STREQUAL "STATIC_LIBRARY"
+      AND NOT (APPLE AND (is_app_bundle OR is_bundle)))
+    add_custom_command(TARGET ${target} POST_BUILD
+      COMMAND "${CMAKE_COMMAND}" "-E" "copy_if_different"
+      "${binary_data_pack_file}"
+      "$<TARGET_FILE_DIR:${target}>"
+    )
+  endif()
+
   if(APPLE)
     _FRUT_add_extra_commands_APPLE(${target} "${exporter}")
   elseif(MSVC)
@@ -3558,7 +3720,20 @@ function(_FRUT_build_and_install_tool tool_name tool_version)
   if(NOT ${tool_name}_exe)
     set(binary_dir "${Reprojucer.cmake_DIR}/tools/_build/${CMAKE_GENERATOR}")
 
-    message(STATUS "Configuring ${tool_name} in \"${binary_dir}\"")
+    option(JUCER_BUILD_ALL_TOOLS
+      "If ON, build all the tools of FRUT together the first time one of them is needed"
+    )
+    if(JUCER_BUILD_ALL_TOOLS)
+      # A single build of all the tools compiles the JUCE modules they share only once,
+      # instead of once per tool
+      set(tool_to_build "all")
+      set(tools_to_build "all the tools")
+    else()
+      set(tool_to_build "${tool_name}")
+      set(tools_to_build "${tool_name}")
+    endif()
+
+    message(STATUS "Configuring ${tools_to_build} in \"${binary_dir}\"")
     file(MAKE_DIRECTORY "${binary_dir}")
     execute_process(
       COMMAND
@@ -3568,7 +3743,7 @@ function(_FRUT_build_and_install_tool tool_name tool_version)
         "-DJUCE_modules_DIRS=${JUCER_PROJECT_MODULES_FOLDERS}"
         "-DCMAKE_INSTALL_PREFIX=${install_prefix}"
         "-Dbuilt_by_Reprojucer=TRUE"
-        "-Dtool_to_build=${tool_name}"
+        "-Dtool_to_build=${tool_to_build}"
       WORKING_DIRECTORY "${binary_dir}"
       OUTPUT_VARIABLE configure_output
       RESULT_VARIABLE configure_result
@@ -3578,7 +3753,7 @@ function(_FRUT_build_and_install_tool tool_name tool_version)
       _FRUT_write_failure_report_and_abort("configure" "${tool_name}" "${output}")
     endif()
 
-    message(STATUS "Building ${tool_name} in \"${binary_dir}\"")
+    message(STATUS "Building ${tools_to_build} in \"${binary_dir}\"")
     set(build_command "${CMAKE_COMMAND}" "--build" "${binary_dir}")
     if(CMAKE_GENERATOR STREQUAL "Xcode")
       list(APPEND build_command "--" "-parallelizeTargets")
@@ -3595,7 +3770,7 @@ function(_FRUT_build_and_install_tool tool_name tool_version)
       _FRUT_write_failure_report_and_abort("build" "${tool_name}" "${output}")
     endif()
 
-    message(STATUS "Installing ${tool_name} in \"${install_prefix}\"")
+    message(STATUS "Installing ${tools_to_build} in \"${install_prefix}\"")
     execute_process(
       COMMAND "${CMAKE_COMMAND}" "--build" "${binary_dir}" "--target" "install"
       OUTPUT_VARIABLE install_output
@@ -3606,7 +3781,7 @@ function(_FRUT_build_and_install_tool tool_name tool_version)
       _FRUT_write_failure_report_and_abort("install" "${tool_name}" "${output}")
     endif()
 
-    message(STATUS "Installed ${tool_name} in \"${install_prefix}\"")
+    message(STATUS "Installed ${tools_to_build} in \"${install_prefix}\"")
     find_program(${tool_name}_exe "${tool_filename}"
       PATHS "${install_prefix}"
       NO_DEFAULT_PATH
@@ -3851,36 +4026,6 @@ function(_FRUT_compute_vst3_category out_var)
 endfunction()
 
 
-function(_FRUT_create_xcassets_folder_from_icons out_var)
-
-  _FRUT_build_and_install_tool("XcassetsBuilder" "0.1.0")
-
-  set(XcassetsBuilder_args "${CMAKE_CURRENT_BINARY_DIR}/${JUCER_PROJECT_NAME}")
-  if(DEFINED JUCER_SMALL_ICON)
-    list(APPEND XcassetsBuilder_args "${JUCER_SMALL_ICON}")
-  else()
-    list(APPEND XcassetsBuilder_args "<None>")
-  endif()
-  if(DEFINED JUCER_LARGE_ICON)
-    list(APPEND XcassetsBuilder_args "${JUCER_LARGE_ICON}")
-  else()
-    list(APPEND XcassetsBuilder_args "<None>")
-  endif()
-
-  execute_process(
-    COMMAND "${XcassetsBuilder_exe}" ${XcassetsBuilder_args}
-    OUTPUT_VARIABLE xcassets_path
-    RESULT_VARIABLE XcassetsBuilder_return_code
-  )
-  if(NOT XcassetsBuilder_return_code EQUAL 0)
-    message(FATAL_ERROR "Error when executing XcassetsBuilder")
-  endif()
-
-  set(${out_var} "${xcassets_path}" PARENT_SCOPE)
-
-endfunction()
-
-
 function(_FRUT_dec_to_hex dec_value out_hex_value)
 
   if(dec_value EQUAL 0)
@@ -4045,6 +4190,55 @@ function(_FRUT_generate_AppConfig_and_JucePluginDefines_header)
 endfunction()
 
 
+function(_FRUT_generate_custom_plist_files)
+
+  get_property(num_jobs GLOBAL PROPERTY FRUT_PLIST_NUM_JOBS)
+  if(NOT num_jobs)
+    return()
+  endif()
+
+  _FRUT_build_and_install_tool("PListMerger" "0.3.0")
+
+  set(custom_plist_file "${CMAKE_CURRENT_BINARY_DIR}/PListMerger/CustomPlist.plist")
+  get_property(custom_plist GLOBAL PROPERTY FRUT_PLIST_CUSTOM_PLIST)
+  file(WRITE "${custom_plist_file}" "${custom_plist}")
+
+  set(PListMerger_args "")
+  math(EXPR last_job "${num_jobs} - 1")
+  foreach(job RANGE ${last_job})
+    get_property(plist_entries_file GLOBAL PROPERTY FRUT_PLIST_JOB_${job}_ENTRIES_FILE)
+    list(APPEND PListMerger_args
+      "@${plist_entries_file}" "--output=${plist_entries_file}.merged"
+    )
+  endforeach()
+
+  execute_process(
+    COMMAND
+    "${PListMerger_exe}"
+    "--template=${Reprojucer_data_DIR}/Info.plist.in"
+    "@${custom_plist_file}"
+    ${PListMerger_args}
+    RESULT_VARIABLE PListMerger_return_code
+  )
+  if(NOT PListMerger_return_code EQUAL 0)
+    message(FATAL_ERROR "Error when executing PListMerger")
+  endif()
+
+  foreach(job RANGE ${last_job})
+    get_property(plist_entries_file GLOBAL PROPERTY FRUT_PLIST_JOB_${job}_ENTRIES_FILE)
+    get_property(plist_file GLOBAL PROPERTY FRUT_PLIST_JOB_${job}_PLIST_FILE)
+    get_property(variables GLOBAL PROPERTY FRUT_PLIST_JOB_${job}_VARIABLES)
+    foreach(variable IN LISTS variables)
+      get_property(${variable} GLOBAL PROPERTY FRUT_PLIST_JOB_${job}_VALUE_${variable})
+    endforeach()
+    configure_file("${plist_entries_file}.merged" "${plist_file}" @ONLY)
+  endforeach()
+
+  set_property(GLOBAL PROPERTY FRUT_PLIST_NUM_JOBS 0)
+
+endfunction()
+
+
 function(_FRUT_generate_entitlements_file target output_filename out_var)
 
   set(entitlements_content "")
@@ -4137,16 +4331,16 @@ function(_FRUT_generate_entitlements_file target output_filename out_var)
 endfunction()
 
 
-function(_FRUT_generate_icon_file icon_format icon_file_output_dir out_icon_filename)
+function(_FRUT_generate_icon_assets outputs out_icon_filename out_xcassets)
 
-  _FRUT_build_and_install_tool("IconBuilder" "0.2.0")
+  _FRUT_build_and_install_tool("IconBuilder" "0.6.0")
 
   if(DEFINED JUCER_VERSION)
     set(projucer_version "${JUCER_VERSION}")
   else()
     set(projucer_version "latest")
   endif()
-  set(IconBuilder_args "${projucer_version}" "${icon_format}" "${icon_file_output_dir}")
+  set(IconBuilder_args "${projucer_version}")
   if(DEFINED JUCER_SMALL_ICON)
     list(APPEND IconBuilder_args "${JUCER_SMALL_ICON}")
   else()
@@ -4157,19 +4351,35 @@ function(_FRUT_generate_icon_file icon_format icon_file_output_dir out_icon_file
   else()
     list(APPEND IconBuilder_args "<None>")
   endif()
+  list(APPEND IconBuilder_args "${CMAKE_CURRENT_BINARY_DIR}/IconCache")
+  foreach(output IN LISTS outputs)
+    if(output STREQUAL "xcassets")
+      list(APPEND IconBuilder_args
+        "--xcassets=${CMAKE_CURRENT_BINARY_DIR}/${JUCER_PROJECT_NAME}"
+      )
+    else()
+      list(APPEND IconBuilder_args "--${output}=${CMAKE_CURRENT_BINARY_DIR}")
+    endif()
+  endforeach()
 
   execute_process(
     COMMAND "${IconBuilder_exe}" ${IconBuilder_args}
-    OUTPUT_VARIABLE icon_filename
+    OUTPUT_VARIABLE IconBuilder_output
     RESULT_VARIABLE IconBuilder_return_code
   )
   if(NOT IconBuilder_return_code EQUAL 0)
     message(FATAL_ERROR "Error when executing IconBuilder")
   endif()
 
-  if(NOT "${icon_filename}" STREQUAL "")
-    set(${out_icon_filename} "${icon_filename}" PARENT_SCOPE)
-  endif()
+  # IconBuilder prints one "<output>=<value>" line per output
+  string(REPLACE "\n" ";" output_lines "${IconBuilder_output}")
+  foreach(output_line IN LISTS output_lines)
+    if(output_line MATCHES "^(icns|ico)=(.+)$")
+      set(${out_icon_filename} "${CMAKE_MATCH_2}" PARENT_SCOPE)
+    elseif(output_line MATCHES "^xcassets=(.+)$")
+      set(${out_xcassets} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+    endif()
+  endforeach()
 
 endfunction()
 
@@ -4178,7 +4388,7 @@ function(_FRUT_generate_JuceHeader_header)
 
   list(LENGTH JUCER_PROJECT_RESOURCES resources_count)
   if(resources_count GREATER 0)
-    _FRUT_build_and_install_tool("BinaryDataBuilder" "0.3.1")
+    _FRUT_build_and_install_tool("BinaryDataBuilder" "0.25.0")
 
     if(DEFINED JUCER_VERSION)
       set(projucer_version "${JUCER_VERSION}")
@@ -4202,30 +4412,228 @@ function(_FRUT_generate_JuceHeader_header)
     if("${JUCER_BINARYDATA_NAMESPACE}" STREQUAL "")
       set(JUCER_BINARYDATA_NAMESPACE "BinaryData")
     endif()
+    set(binary_data_dir "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode")
     set(BinaryDataBuilder_args
       "${projucer_version}"
-      "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/"
+      "${binary_data_dir}/"
       "${project_uid}"
       ${size_limit_in_bytes}
       "${JUCER_BINARYDATA_NAMESPACE}"
     )
+    set(BinaryDataBuilder_options "")
+    if(DEFINED JUCER_BINARYDATACPP_SHARDS)
+      list(APPEND BinaryDataBuilder_options "--shards=${JUCER_BINARYDATACPP_SHARDS}")
+    endif()
+    if(JUCER_GENERATE_BINARYDATA_AT_BUILD_TIME)
+      set(shard_plan_file "${binary_data_dir}/BinaryData.shardplan")
+      list(APPEND BinaryDataBuilder_options "--shard-plan=${shard_plan_file}")
+    endif()
+    if(JUCER_CACHE_BINARYDATA)
+      list(APPEND BinaryDataBuilder_options "--cache-dir=${binary_data_dir}/BinaryDataCache")
+    endif()
+    if(DEFINED JUCER_BINARYDATA_BACKEND)
+      list(APPEND BinaryDataBuilder_options "--backend=${JUCER_BINARYDATA_BACKEND}")
+    endif()
+    if(JUCER_BINARYDATA_BACKEND STREQUAL "elf")
+      if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+        if(CMAKE_SIZEOF_VOID_P EQUAL 4)
+          set(elf_machine "x86")
+        else()
+          set(elf_machine "x86_64")
+        endif()
+      elseif(CMAKE_SYSTEM_PROCESSOR MATCHES "^i.86$")
+        set(elf_machine "x86")
+      elseif(CMAKE_SYSTEM_PROCESSOR MATCHES "^(aarch64|arm64)$")
+        set(elf_machine "arm64")
+      else()
+        message(FATAL_ERROR "BINARYDATA_BACKEND \"elf\" doesn't support the"
+          " \"${CMAKE_SYSTEM_PROCESSOR}\" processor"
+        )
+      endif()
+      list(APPEND BinaryDataBuilder_options "--elf-machine=${elf_machine}")
+    endif()
+    if(JUCER_BINARYDATA_BACKEND STREQUAL "pack")
+      list(FIND JUCER_PROJECT_MODULES "juce_core" juce_core_index)
+      if(juce_core_index EQUAL -1)
+        message(FATAL_ERROR "BINARYDATA_BACKEND \"pack\" requires the juce_core module")
+      endif()
+      # Copied next to the binary of each target by _FRUT_add_extra_commands(), or to
+      # the Resources folder of macOS bundles by _FRUT_add_bundle_resources()
+      set(binary_data_pack_file "${binary_data_dir}/BinaryData.pack" PARENT_SCOPE)
+    endif()
+    if(DEFINED JUCER_BINARYDATA_ALIGNMENT)
+      list(APPEND BinaryDataBuilder_options "--alignment=${JUCER_BINARYDATA_ALIGNMENT}")
+    endif()
+    if(JUCER_COMPRESS_BINARYDATA)
+      list(FIND JUCER_PROJECT_MODULES "juce_core" juce_core_index)
+      if(juce_core_index EQUAL -1)
+        message(FATAL_ERROR "COMPRESS_BINARYDATA requires the juce_core module")
+      endif()
+      list(APPEND BinaryDataBuilder_options "--compress")
+    endif()
+    if(JUCER_DEDUPLICATE_BINARYDATA)
+      list(APPEND BinaryDataBuilder_options "--deduplicate")
+    endif()
+    if(DEFINED JUCER_BINARYDATA_LOOKUP)
+      list(APPEND BinaryDataBuilder_options "--lookup=${JUCER_BINARYDATA_LOOKUP}")
+    endif()
+    if(JUCER_BINARYDATA_CONSTEXPR_INDEX)
+      if(JUCER_CXX_LANGUAGE_STANDARD STREQUAL "11"
+          OR JUCER_CXX_LANGUAGE_STANDARD STREQUAL "14")
+        message(FATAL_ERROR "BINARYDATA_CONSTEXPR_INDEX requires C++17 or later")
+      endif()
+      list(APPEND BinaryDataBuilder_options "--constexpr-index")
+    endif()
+    if(JUCER_BINARYDATA_CONTENT_HASHES)
+      list(APPEND BinaryDataBuilder_options "--content-hashes")
+    endif()
+    set(predecoded_extensions "")
+    set(predecoded_files "")
+    foreach(item IN LISTS JUCER_PREDECODE_BINARYDATA_IMAGES)
+      if(item MATCHES "^\\.")
+        string(TOLOWER "${item}" extension)
+        list(APPEND predecoded_extensions "${extension}")
+      else()
+        get_filename_component(item_abs_path "${item}" ABSOLUTE)
+        list(APPEND predecoded_files "${item_abs_path}")
+      endif()
+    endforeach()
+    set(ImageDecoder_args "")
+    set(images_abs_paths "")
+    set(decoded_images "")
+    set(resources_abs_paths "")
     foreach(resource_path IN LISTS JUCER_PROJECT_RESOURCES)
       get_filename_component(resource_abs_path "${resource_path}" ABSOLUTE)
-      list(APPEND BinaryDataBuilder_args "${resource_abs_path}")
+      string(REGEX MATCH "\\.[^./]*$" extension "${resource_abs_path}")
+      string(TOLOWER "${extension}" extension)
+      if(extension IN_LIST predecoded_extensions
+          OR resource_abs_path IN_LIST predecoded_files)
+        # The decoded image keeps the file name of the image, so that its variable keeps
+        # the same name, in a directory of its own to avoid clashes
+        get_filename_component(resource_dir "${resource_abs_path}" DIRECTORY)
+        get_filename_component(resource_name "${resource_abs_path}" NAME)
+        string(MD5 resource_dir_hash "${resource_dir}")
+        string(SUBSTRING "${resource_dir_hash}" 0 8 resource_dir_hash)
+        set(decoded_image
+          "${binary_data_dir}/DecodedImages/${resource_dir_hash}/${resource_name}"
+        )
+        list(APPEND ImageDecoder_args "${resource_abs_path}" "${decoded_image}")
+        list(APPEND images_abs_paths "${resource_abs_path}")
+        list(APPEND decoded_images "${decoded_image}")
+        set(resource_abs_path "${decoded_image}")
+      endif()
+      list(APPEND resources_abs_paths "${resource_abs_path}")
     endforeach()
-    execute_process(
-      COMMAND "${BinaryDataBuilder_exe}" ${BinaryDataBuilder_args}
-      OUTPUT_VARIABLE binary_data_filenames
-      RESULT_VARIABLE BinaryDataBuilder_return_code
-    )
-    if(NOT BinaryDataBuilder_return_code EQUAL 0)
-      message(FATAL_ERROR "Error when executing BinaryDataBuilder")
+
+    if(ImageDecoder_args)
+      list(FIND JUCER_PROJECT_MODULES "juce_graphics" juce_graphics_index)
+      if(juce_graphics_index EQUAL -1)
+        message(FATAL_ERROR
+          "PREDECODE_BINARYDATA_IMAGES requires the juce_graphics module"
+        )
+      endif()
+      _FRUT_build_and_install_tool("ImageDecoder" "0.4.0")
+      # The images are decoded when configuring even when the BinaryData files are
+      # generated at build time, so that their sizes are known when planning
+      execute_process(
+        COMMAND "${ImageDecoder_exe}" ${ImageDecoder_args}
+        RESULT_VARIABLE ImageDecoder_return_code
+      )
+      if(NOT ImageDecoder_return_code EQUAL 0)
+        message(FATAL_ERROR "Error when executing ImageDecoder")
+      endif()
+      if(JUCER_GENERATE_BINARYDATA_AT_BUILD_TIME)
+        add_custom_command(
+          OUTPUT ${decoded_images}
+          COMMAND "${ImageDecoder_exe}" ${ImageDecoder_args}
+          DEPENDS "${ImageDecoder_exe}" ${images_abs_paths}
+          COMMENT "Decoding BinaryData images"
+          VERBATIM
+        )
+      endif()
+      list(APPEND BinaryDataBuilder_options "--decoded-images")
     endif()
 
-    foreach(filename IN LISTS binary_data_filenames)
-      list(APPEND JUCER_PROJECT_FILES
-        "${CMAKE_CURRENT_BINARY_DIR}/JuceLibraryCode/${filename}"
+    if(NOT JUCER_GENERATE_BINARYDATA_AT_BUILD_TIME)
+      option(JUCER_BATCH_BINARYDATA
+        "If ON, generate BinaryData files when calling jucer_generate_binarydata()"
+      )
+    endif()
+
+    if(JUCER_GENERATE_BINARYDATA_AT_BUILD_TIME)
+      # Only compute which BinaryData files will be generated, the resources are
+      # read and encoded when building
+      execute_process(
+        COMMAND
+        "${BinaryDataBuilder_exe}" ${BinaryDataBuilder_args}
+        ${BinaryDataBuilder_options} "--plan-only"
+        ${resources_abs_paths}
+        OUTPUT_VARIABLE binary_data_filenames
+        RESULT_VARIABLE BinaryDataBuilder_return_code
+      )
+      if(NOT BinaryDataBuilder_return_code EQUAL 0)
+        message(FATAL_ERROR "Error when executing BinaryDataBuilder")
+      endif()
+
+      set(binary_data_files "")
+      foreach(filename IN LISTS binary_data_filenames)
+        list(APPEND binary_data_files "${binary_data_dir}/${filename}")
+      endforeach()
+      set(binary_data_stamp_file "${CMAKE_CURRENT_BINARY_DIR}/BinaryData.stamp")
+      add_custom_command(
+        OUTPUT "${binary_data_stamp_file}"
+        BYPRODUCTS ${binary_data_files}
+        COMMAND
+        "${BinaryDataBuilder_exe}" ${BinaryDataBuilder_args}
+        ${BinaryDataBuilder_options}
+        ${resources_abs_paths}
+        COMMAND "${CMAKE_COMMAND}" "-E" "touch" "${binary_data_stamp_file}"
+        DEPENDS
+        "${BinaryDataBuilder_exe}"
+        "${shard_plan_file}"
+        ${resources_abs_paths}
+        COMMENT "Generating BinaryData files"
+        VERBATIM
+      )
+      list(APPEND JUCER_PROJECT_FILES "${binary_data_stamp_file}")
+    elseif(JUCER_BATCH_BINARYDATA)
+      # The BinaryData files are generated by jucer_generate_binarydata(), together with
+      # the ones of the other projects, and added to the target of this project then
+      get_property(binary_data_job GLOBAL PROPERTY FRUT_BINARYDATA_NUM_JOBS)
+      if(NOT binary_data_job)
+        set(binary_data_job 0)
+      endif()
+      set(job_manifest "")
+      foreach(arg IN LISTS
+          BinaryDataBuilder_args BinaryDataBuilder_options resources_abs_paths)
+        string(APPEND job_manifest "${arg}\n")
+      endforeach()
+      string(APPEND job_manifest "--file-list=${binary_data_dir}/BinaryData.files\n\n")
+      set_property(GLOBAL APPEND_STRING PROPERTY
+        FRUT_BINARYDATA_MANIFEST "${job_manifest}"
+      )
+      set_property(GLOBAL PROPERTY
+        FRUT_BINARYDATA_JOB_${binary_data_job}_DIR "${binary_data_dir}"
       )
+      math(EXPR num_jobs "${binary_data_job} + 1")
+      set_property(GLOBAL PROPERTY FRUT_BINARYDATA_NUM_JOBS ${num_jobs})
+      set(binary_data_job ${binary_data_job} PARENT_SCOPE)
+    else()
+      execute_process(
+        COMMAND
+        "${BinaryDataBuilder_exe}" ${BinaryDataBuilder_args}
+        ${BinaryDataBuilder_options}
+        ${resources_abs_paths}
+        OUTPUT_VARIABLE binary_data_filenames
+        RESULT_VARIABLE BinaryDataBuilder_return_code
+      )
+      if(NOT BinaryDataBuilder_return_code EQUAL 0)
+        message(FATAL_ERROR "Error when executing BinaryDataBuilder")
+      endif()
+    endif()
+
+    foreach(filename IN LISTS binary_data_filenames)
+      list(APPEND JUCER_PROJECT_FILES "${binary_data_dir}/${filename}")
     endforeach()
     if(DEFINED JUCER_INCLUDE_BINARYDATA AND NOT JUCER_INCLUDE_BINARYDATA)
       set(binary_data_include "")
@@ -4779,31 +5187,53 @@ function(_FRUT_generate_plist_file
   endif()
 
   if(JUCER_CUSTOM_PLIST)
-    _FRUT_build_and_install_tool("PListMerger" "0.1.0")
+    # The plist file is generated by _FRUT_generate_custom_plist_files(), which merges
+    # the custom plist with the entries of all the plist files of the project in a single
+    # PListMerger run. The @VAR@ references are only substituted then, so the values of
+    # the variables that they reference are saved now.
+    get_property(plist_job GLOBAL PROPERTY FRUT_PLIST_NUM_JOBS)
+    if(NOT plist_job)
+      set(plist_job 0)
+    else()
+      get_property(custom_plist GLOBAL PROPERTY FRUT_PLIST_CUSTOM_PLIST)
+      if(NOT custom_plist STREQUAL JUCER_CUSTOM_PLIST)
+        message(FATAL_ERROR "All the plist files generated by a single PListMerger run"
+          " must have the same custom plist"
+        )
+      endif()
+    endif()
 
-    execute_process(
-      COMMAND
-      "${PListMerger_exe}"
-      "${JUCER_CUSTOM_PLIST}"
-      "<plist><dict>${plist_entries}</dict></plist>"
-      OUTPUT_VARIABLE PListMerger_output
-      OUTPUT_STRIP_TRAILING_WHITESPACE
-      RESULT_VARIABLE PListMerger_return_code
+    set(plist_entries_file
+      "${CMAKE_CURRENT_BINARY_DIR}/PListMerger/Info-${plist_suffix}-entries.plist"
     )
-    if(NOT PListMerger_return_code EQUAL 0)
-      message(FATAL_ERROR "Error when executing PListMerger")
-    endif()
+    file(WRITE "${plist_entries_file}" "<plist><dict>${plist_entries}</dict></plist>")
 
-    if(WIN32)
-      string(REPLACE "\r\n" "\n" PListMerger_output "${PListMerger_output}")
-    endif()
-    string(REPLACE "<plist>\n  <dict>" "" PListMerger_output "${PListMerger_output}")
-    string(REPLACE "\n  </dict>\n</plist>" "" PListMerger_output "${PListMerger_output}")
-    set(plist_entries "${PListMerger_output}")
-  endif()
+    string(REGEX MATCHALL "@[A-Za-z_0-9/.+-]+@" references
+      "${JUCER_CUSTOM_PLIST}\n${plist_entries}"
+    )
+    set(variables "")
+    foreach(reference IN LISTS references)
+      string(REGEX REPLACE "^@(.+)@$" "\\1" variable "${reference}")
+      list(APPEND variables "${variable}")
+      set_property(GLOBAL PROPERTY
+        FRUT_PLIST_JOB_${plist_job}_VALUE_${variable} "${${variable}}"
+      )
+    endforeach()
 
-  string(CONFIGURE "${plist_entries}" plist_entries @ONLY)
-  configure_file("${Reprojucer_data_DIR}/Info.plist.in" "${plist_filename}" @ONLY)
+    set_property(GLOBAL PROPERTY FRUT_PLIST_CUSTOM_PLIST "${JUCER_CUSTOM_PLIST}")
+    set_property(GLOBAL PROPERTY
+      FRUT_PLIST_JOB_${plist_job}_ENTRIES_FILE "${plist_entries_file}"
+    )
+    set_property(GLOBAL PROPERTY FRUT_PLIST_JOB_${plist_job}_PLIST_FILE
+      "${CMAKE_CURRENT_BINARY_DIR}/${plist_filename}"
+    )
+    set_property(GLOBAL PROPERTY FRUT_PLIST_JOB_${plist_job}_VARIABLES "${variables}")
+    math(EXPR num_jobs "${plist_job} + 1")
+    set_property(GLOBAL PROPERTY FRUT_PLIST_NUM_JOBS ${num_jobs})
+  else()
+    string(CONFIGURE "${plist_entries}" plist_entries @ONLY)
+    configure_file("${Reprojucer_data_DIR}/Info.plist.in" "${plist_filename}" @ONLY)
+  endif()
 
 endfunction()
 
@@ -5270,6 +5700,12 @@ function(_FRUT_install_to_plugin_binary_location target plugin_type default_dest
             COMPONENT "${component}" DESTINATION "${destination}"
           )
         endif()
+        # On macOS, BinaryData.pack is in the Resources folder of the bundle
+        if(DEFINED binary_data_pack_file AND NOT APPLE)
+          install(FILES "${binary_data_pack_file}" CONFIGURATIONS "${config}"
+            COMPONENT "${component}" DESTINATION "${destination}"
+          )
+        endif()
         set(should_install TRUE)
       endif()
     endif()
@@ -0,0 +1,91 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../extras/Projucer/Source/jucer_Headers.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+// Measures how fast CodeHelpers::writeDataAsCppLiteral() encodes binary resources (written
+// as numeric arrays) and text resources (written as string literals)
+int main(int argc, char* argv[])
+{
+  const auto numMegabytes = [argc, argv]() {
+    try
+    {
+      return argc > 1 ? std::stoi(argv[1]) : 64;
+    }
+    catch (const std::invalid_argument&)
+    {
+      std::cerr << "usage: LiteralEncoderBenchmark [<number-of-megabytes>]" << std::endl;
+      std::exit(1);
+    }
+  }();
+
+  const auto totalSize = static_cast<size_t>(numMegabytes) * 1024 * 1024;
+
+  auto random = Random{42};
+
+  MemoryBlock binaryData{totalSize};
+  random.fillBitsRandomly(binaryData.getData(), binaryData.getSize());
+
+  // String literals are only used for resources smaller than 32 KiB, so the text-like
+  // input is split in blocks of 16 KiB
+  const auto textBlockSize = size_t{16 * 1024};
+  const auto words = StringArray{"lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+                                 "adipiscing", "elit", "\"quoted\"", "tab\t", "path\\to",
+                                 "what??", "0xFF"};
+  Array<MemoryBlock> textBlocks;
+  for (auto remaining = totalSize; remaining > 0;)
+  {
+    MemoryOutputStream text;
+    while (text.getDataSize() < textBlockSize)
+    {
+      text << words[random.nextInt(words.size())]
+           << (random.nextInt(12) == 0 ? "\n" : " ");
+    }
+
+    const auto blockSize = jmin(textBlockSize, remaining);
+    textBlocks.add(MemoryBlock{text.getData(), blockSize});
+    remaining -= blockSize;
+  }
+
+  const auto benchmark = [totalSize](const char* name, const Array<MemoryBlock>& blocks) {
+    MemoryOutputStream out;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& block : blocks)
+    {
+      CodeHelpers::writeDataAsCppLiteral(block, out, true, true);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << name << " (" << totalSize << " bytes): "
+              << static_cast<double>(totalSize) / (1024 * 1024) / seconds << " MB/s, "
+              << out.getDataSize() << " bytes of code" << std::endl;
+  };
+
+  benchmark("binary", Array<MemoryBlock>{binaryData});
+  benchmark("text", textBlocks);
+
+  return 0;
+}
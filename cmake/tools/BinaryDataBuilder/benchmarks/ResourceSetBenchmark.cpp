@@ -0,0 +1,366 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../extras/Projucer/Source/jucer_Headers.h"
+#include "../extras/Projucer/Source/Project Saving/jucer_ResourceFile.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+struct ResourceSet
+{
+  const char* name;
+  int numFiles;
+  size_t fileSize;
+  bool isText;
+};
+
+const ResourceSet resourceSets[] = {
+  {"many-tiny-files", 5000, 64, true},
+  {"few-huge-files", 3, 64 * 1024 * 1024, false},
+  {"text", 256, 16 * 1024, true},
+  {"binary", 256, 256 * 1024, false},
+};
+
+
+const char* getElfMachine()
+{
+#if JUCE_LINUX && defined(__x86_64__)
+  return "x86_64";
+#elif JUCE_LINUX && defined(__i386__)
+  return "x86";
+#elif JUCE_LINUX && defined(__aarch64__)
+  return "arm64";
+#else
+  return nullptr;
+#endif
+}
+
+
+struct Measurement
+{
+  bool succeeded;
+  double seconds;
+  int64 peakRssKiB;
+};
+
+
+// Runs function in a child process, so that the peak RSS of each run is measured
+// independently of the others and of the benchmark itself
+Measurement measureInChildProcess(const std::function<int()>& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  const auto pid = fork();
+  if (pid == 0)
+  {
+    _exit(function());
+  }
+
+  auto status = 0;
+  struct rusage usage = {};
+  const auto waitResult = pid > 0 ? wait4(pid, &status, 0, &usage) : -1;
+
+  const auto end = std::chrono::steady_clock::now();
+
+#if JUCE_MAC
+  const auto peakRssKiB = static_cast<int64>(usage.ru_maxrss) / 1024;
+#else
+  const auto peakRssKiB = static_cast<int64>(usage.ru_maxrss);
+#endif
+
+  return {waitResult == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0,
+          std::chrono::duration<double>(end - start).count(), peakRssKiB};
+}
+
+
+Measurement runCommand(const StringArray& command)
+{
+  return measureInChildProcess([&command]() {
+    std::vector<char*> argv;
+    for (const auto& arg : command)
+    {
+      argv.push_back(const_cast<char*>(arg.toRawUTF8()));
+    }
+    argv.push_back(nullptr);
+
+    execvp(argv[0], argv.data());
+    return 127;
+  });
+}
+
+
+Array<File> generateResourceFiles(const ResourceSet& resourceSet, const File& directory)
+{
+  directory.createDirectory();
+
+  auto random = Random{42};
+  const auto words = StringArray{"lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+                                 "adipiscing", "elit", "\"quoted\"", "tab\t", "path\\to"};
+
+  Array<File> files;
+
+  for (auto i = 0; i < resourceSet.numFiles; ++i)
+  {
+    const auto file = directory.getChildFile(
+      "resource_" + String{i} + (resourceSet.isText ? ".txt" : ".bin"));
+    files.add(file);
+
+    // The data only depends on the index of the file, so it can be reused across runs
+    if (file.getSize() == static_cast<int64>(resourceSet.fileSize))
+    {
+      continue;
+    }
+
+    MemoryBlock data{resourceSet.fileSize};
+
+    if (resourceSet.isText)
+    {
+      MemoryOutputStream text;
+      while (text.getDataSize() < resourceSet.fileSize)
+      {
+        text << words[random.nextInt(words.size())]
+             << (random.nextInt(12) == 0 ? "\n" : " ");
+      }
+      data.copyFrom(text.getData(), 0, resourceSet.fileSize);
+    }
+    else
+    {
+      random.fillBitsRandomly(data.getData(), data.getSize());
+    }
+
+    file.replaceWithData(data.getData(), data.getSize());
+  }
+
+  return files;
+}
+
+
+template <ProjucerVersion jucerVersion>
+int writeBinaryDataFiles(const File& outputDir,
+                         const Array<File>& resourceFiles,
+                         BinaryDataBackend backend)
+{
+  Project project{outputDir.getFullPathName(), "FRUT"};
+
+  ResourceFile resourceFile{project};
+  resourceFile.setClassName("BinaryData");
+  resourceFile.setNumberOfThreads(static_cast<int>(std::thread::hardware_concurrency()));
+  resourceFile.setBackend(backend);
+
+  if (backend == BinaryDataBackend::elfObject)
+  {
+    resourceFile.setElfMachine(getElfMachine());
+  }
+
+  for (const auto& file : resourceFiles)
+  {
+    resourceFile.addFile(file);
+  }
+
+  Array<File> binaryDataFiles;
+  const auto result = resourceFile.write<jucerVersion>(binaryDataFiles, 10240 * 1024);
+
+  if (!result.wasOk())
+  {
+    std::cerr << result.getErrorMessage() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+
+var toJson(const Measurement& measurement)
+{
+  auto object = new DynamicObject{};
+  object->setProperty("succeeded", measurement.succeeded);
+  object->setProperty("seconds", measurement.seconds);
+  object->setProperty("peakRssKiB", measurement.peakRssKiB);
+  return var{object};
+}
+
+} // namespace
+
+
+// Generates synthetic resource sets, writes their BinaryData files with each Projucer
+// version and backend, and compiles the BinaryData*.cpp files with the host compiler.
+// The time and peak RSS of each step are written to a JSON report.
+int main(int argc, char* argv[])
+{
+  const auto reportOption = String{"--report="};
+  const auto compilerOption = String{"--compiler="};
+
+  auto workDir = File{};
+  auto reportFile = File{};
+  auto compiler = String{FRUT_HOST_CXX_COMPILER};
+
+  for (auto i = 1; i < argc; ++i)
+  {
+    const auto arg = String{argv[i]};
+
+    if (arg.startsWith(reportOption))
+    {
+      reportFile = File::getCurrentWorkingDirectory().getChildFile(
+        arg.substring(reportOption.length()));
+    }
+    else if (arg.startsWith(compilerOption))
+    {
+      compiler = arg.substring(compilerOption.length());
+    }
+    else if (workDir == File{})
+    {
+      workDir = File::getCurrentWorkingDirectory().getChildFile(arg);
+    }
+    else
+    {
+      workDir = File{};
+      break;
+    }
+  }
+
+  if (workDir == File{})
+  {
+    std::cerr << "usage: ResourceSetBenchmark <work-dir>"
+              << " [--report=<report-file>]"
+              << " [--compiler=<cxx-compiler>]" << std::endl;
+    return 1;
+  }
+
+  if (reportFile == File{})
+  {
+    reportFile = workDir.getChildFile("ResourceSetBenchmark.json");
+  }
+
+  struct Backend
+  {
+    const char* name;
+    BinaryDataBackend backend;
+  };
+
+  std::vector<Backend> backends{{"literals", BinaryDataBackend::cppLiterals},
+                                {"incbin", BinaryDataBackend::incbin}};
+  if (getElfMachine() != nullptr)
+  {
+    backends.push_back({"elf", BinaryDataBackend::elfObject});
+  }
+
+  struct Version
+  {
+    const char* name;
+    int (*write)(const File&, const Array<File>&, BinaryDataBackend);
+  };
+
+  const Version versions[] = {
+    {"4.2.0", &writeBinaryDataFiles<ProjucerVersion::v4_2_0>},
+    {"5.0.0", &writeBinaryDataFiles<ProjucerVersion::v5_0_0>},
+    {"5.3.1", &writeBinaryDataFiles<ProjucerVersion::v5_3_1>},
+  };
+
+  Array<var> results;
+  auto allSucceeded = true;
+
+  for (const auto& resourceSet : resourceSets)
+  {
+    const auto resourceFiles = generateResourceFiles(
+      resourceSet, workDir.getChildFile("resources").getChildFile(resourceSet.name));
+
+    for (const auto& version : versions)
+    {
+      for (const auto& backend : backends)
+      {
+        const auto outputDir = workDir.getChildFile("BinaryData")
+                                 .getChildFile(resourceSet.name)
+                                 .getChildFile(version.name)
+                                 .getChildFile(backend.name);
+        outputDir.deleteRecursively();
+
+        const auto generation = measureInChildProcess([&]() {
+          return version.write(outputDir, resourceFiles, backend.backend);
+        });
+
+        Array<File> cppFiles;
+        outputDir.findChildFiles(cppFiles, File::findFiles, false, "BinaryData*.cpp");
+        cppFiles.sort();
+
+        auto compilation = Measurement{generation.succeeded, 0.0, 0};
+        for (const auto& cppFile : cppFiles)
+        {
+          StringArray command;
+          command.add(compiler);
+          command.addArray(StringArray{"-std=c++17", "-O2", "-c", "-o"});
+          command.add(cppFile.withFileExtension(".cpp.o").getFullPathName());
+          command.add(cppFile.getFullPathName());
+
+          const auto measurement = runCommand(command);
+          compilation.succeeded = compilation.succeeded && measurement.succeeded;
+          compilation.seconds += measurement.seconds;
+          compilation.peakRssKiB =
+            std::max(compilation.peakRssKiB, measurement.peakRssKiB);
+        }
+
+        allSucceeded = allSucceeded && generation.succeeded && compilation.succeeded;
+
+        std::cout << resourceSet.name << " " << version.name << " " << backend.name
+                  << ": generation " << generation.seconds << " s, "
+                  << generation.peakRssKiB << " KiB; compilation of " << cppFiles.size()
+                  << " files " << compilation.seconds << " s, " << compilation.peakRssKiB
+                  << " KiB" << std::endl;
+
+        auto result = new DynamicObject{};
+        result->setProperty("resourceSet", resourceSet.name);
+        result->setProperty("numFiles", resourceSet.numFiles);
+        const auto totalSize =
+          static_cast<int64>(resourceSet.fileSize) * resourceSet.numFiles;
+        result->setProperty("totalSize", totalSize);
+        result->setProperty("projucerVersion", version.name);
+        result->setProperty("backend", backend.name);
+        result->setProperty("generation", toJson(generation));
+        result->setProperty("numCppFiles", cppFiles.size());
+        result->setProperty("compilation", toJson(compilation));
+        results.add(var{result});
+      }
+    }
+  }
+
+  auto report = new DynamicObject{};
+  report->setProperty("compiler", compiler);
+  report->setProperty("results", results);
+
+  if (!reportFile.replaceWithText(JSON::toString(var{report})))
+  {
+    std::cerr << "Can't write to file: " << reportFile.getFullPathName() << std::endl;
+    return 1;
+  }
+
+  std::cout << "Report written to " << reportFile.getFullPathName() << std::endl;
+
+  return allSucceeded ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../extras/Projucer/Source/jucer_Headers.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+// Measures how long it takes to write the lookup code of getNamedResource() for a lot of
+// synthetic resource names, like "resource_00042_png"
+int main(int argc, char* argv[])
+{
+  const auto numStrings = [argc, argv]() {
+    try
+    {
+      return argc > 1 ? std::stoi(argv[1]) : 50000;
+    }
+    catch (const std::invalid_argument&)
+    {
+      std::cerr << "usage: StringMatcherBenchmark [<number-of-strings>]" << std::endl;
+      std::exit(1);
+    }
+  }();
+
+  StringArray strings;
+  StringArray codeToExecute;
+  for (auto i = 0; i < numStrings; ++i)
+  {
+    strings.add("resource_" + String{i}.paddedLeft('0', 5) + "_png");
+    codeToExecute.add("numBytes = " + String{i} + "; return resource_"
+                      + String{i}.paddedLeft('0', 5) + "_png;");
+  }
+
+  using CreateMatcherFunction = std::function<void(OutputStream&)>;
+
+  const auto benchmark = [numStrings](const char* name,
+                                      const CreateMatcherFunction& createMatcher) {
+    MemoryOutputStream out;
+
+    const auto start = std::chrono::steady_clock::now();
+    createMatcher(out);
+    const auto end = std::chrono::steady_clock::now();
+
+    std::cout << name << " (" << numStrings << " strings): "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms, "
+              << out.getDataSize() << " bytes of code" << std::endl;
+  };
+
+  benchmark("createStringMatcher", [&strings, &codeToExecute](OutputStream& out) {
+    CodeHelpers::createStringMatcher(out, "resourceNameUTF8", strings, codeToExecute, 4);
+  });
+
+  benchmark("createPerfectHashStringMatcher",
+            [&strings, &codeToExecute](OutputStream& out) {
+              CodeHelpers::createPerfectHashStringMatcher(out, "resourceNameUTF8", strings,
+                                                          codeToExecute, 4);
+            });
+
+  return 0;
+}
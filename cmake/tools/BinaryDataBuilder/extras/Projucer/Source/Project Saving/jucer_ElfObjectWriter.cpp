@@ -0,0 +1,354 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../jucer_Headers.h"
+#include "jucer_ElfObjectWriter.h"
+
+
+namespace ElfObjectWriter
+{
+
+namespace
+{
+
+// See https://refspecs.linuxfoundation.org/elf/gabi4+/contents.html
+
+enum SectionIndex
+{
+  nullSection,
+  rodataSection,
+  noteGnuStackSection,
+  symtabSection,
+  strtabSection,
+  shstrtabSection,
+  numSections
+};
+
+const auto relocatableFileType = 1;
+const auto progbitsSectionType = 1;
+const auto symtabSectionType = 2;
+const auto strtabSectionType = 3;
+const auto allocSectionFlag = 2;
+const auto localSymbolBinding = 0;
+const auto globalSymbolBinding = 1;
+const auto objectSymbolType = 1;
+const auto sectionSymbolType = 3;
+const auto hiddenSymbolVisibility = 2;
+
+struct Machine
+{
+  const char* name;
+  int16 elfMachine;
+  bool is64Bit;
+};
+
+const Machine supportedMachines[] = {
+  {"x86", 3, false},
+  {"x86_64", 62, true},
+  {"arm64", 183, true},
+};
+
+const Machine* findMachine(const String& name)
+{
+  for (const auto& machine : supportedMachines)
+  {
+    if (name == machine.name)
+    {
+      return &machine;
+    }
+  }
+
+  return nullptr;
+}
+
+
+class ElfOutputStream
+{
+public:
+  ElfOutputStream(OutputStream& outputStream, bool is64BitElf)
+    : out(outputStream)
+    , is64Bit{is64BitElf}
+  {
+  }
+
+  void writeHalf(int value)
+  {
+    out.writeShort(static_cast<short>(value));
+  }
+
+  void writeWord(int64 value)
+  {
+    out.writeInt(static_cast<int>(value));
+  }
+
+  // Elf32_Addr/Elf32_Off or Elf64_Addr/Elf64_Off
+  void writeAddress(int64 value)
+  {
+    if (is64Bit)
+    {
+      out.writeInt64(value);
+    }
+    else
+    {
+      out.writeInt(static_cast<int>(value));
+    }
+  }
+
+  void writeByte(int value)
+  {
+    out.writeByte(static_cast<char>(value));
+  }
+
+  void writePadding(int64 alignment)
+  {
+    while (out.getPosition() % alignment != 0)
+    {
+      writeByte(0);
+    }
+  }
+
+  void writeSectionHeader(int name,
+                          int type,
+                          int64 flags,
+                          int64 offset,
+                          int64 size,
+                          int link,
+                          int info,
+                          int64 alignment,
+                          int64 entrySize)
+  {
+    writeWord(name);
+    writeWord(type);
+    writeAddress(flags);
+    writeAddress(0); // sh_addr
+    writeAddress(offset);
+    writeAddress(size);
+    writeWord(link);
+    writeWord(info);
+    writeAddress(alignment);
+    writeAddress(entrySize);
+  }
+
+  void writeSymbol(int name, int binding, int type, int other, int sectionIndex,
+                   int64 value, int64 size)
+  {
+    writeWord(name);
+
+    if (is64Bit)
+    {
+      writeByte((binding << 4) | type);
+      writeByte(other);
+      writeHalf(sectionIndex);
+      writeAddress(value);
+      writeAddress(size);
+    }
+    else
+    {
+      writeAddress(value);
+      writeAddress(size);
+      writeByte((binding << 4) | type);
+      writeByte(other);
+      writeHalf(sectionIndex);
+    }
+  }
+
+  OutputStream& out;
+  const bool is64Bit;
+};
+
+
+int addString(MemoryOutputStream& stringTable, const String& string)
+{
+  const auto offset = static_cast<int>(stringTable.getPosition());
+  stringTable << string;
+  stringTable.writeByte(0);
+  return offset;
+}
+
+} // namespace
+
+
+bool isSupportedMachine(const String& machine)
+{
+  return findMachine(machine) != nullptr;
+}
+
+
+Result write(const File& objectFile,
+             const String& machineName,
+             const Array<File>& resourceFiles,
+             const StringArray& symbols,
+             int dataAlignment)
+{
+  jassert(resourceFiles.size() == symbols.size());
+
+  const auto machine = findMachine(machineName);
+  if (machine == nullptr)
+  {
+    return Result::fail("Unsupported ELF machine: " + machineName);
+  }
+
+  const auto is64Bit = machine->is64Bit;
+  const auto headerSize = is64Bit ? 64 : 52;
+  const auto sectionHeaderSize = is64Bit ? 64 : 40;
+  const auto symbolSize = is64Bit ? 24 : 16;
+  const auto wordAlignment = is64Bit ? 8 : 4;
+
+  const auto alignTo = [](int64 offset, int64 alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+  };
+
+  // The layout of the object file is computed from the sizes of the resource files, so
+  // that they can be copied to the object file one after the other
+  const auto rodataAlignment = jmax(16, dataAlignment);
+  const auto rodataOffset = alignTo(headerSize, rodataAlignment);
+  auto rodataSize = int64{0};
+  Array<int64> dataOffsets;
+
+  for (const auto& resourceFile : resourceFiles)
+  {
+    if (!resourceFile.existsAsFile())
+    {
+      return Result::fail("Can't open resource file: " + resourceFile.getFullPathName());
+    }
+
+    dataOffsets.add(rodataSize);
+    rodataSize = alignTo(rodataSize + resourceFile.getSize() + 1, dataAlignment);
+  }
+
+  MemoryOutputStream symbolStrings;
+  symbolStrings.writeByte(0);
+  Array<int> symbolNames;
+  for (const auto& symbol : symbols)
+  {
+    symbolNames.add(addString(symbolStrings, symbol));
+  }
+
+  MemoryOutputStream sectionStrings;
+  sectionStrings.writeByte(0);
+  const auto rodataName = addString(sectionStrings, ".rodata");
+  const auto noteGnuStackName = addString(sectionStrings, ".note.GNU-stack");
+  const auto symtabName = addString(sectionStrings, ".symtab");
+  const auto strtabName = addString(sectionStrings, ".strtab");
+  const auto shstrtabName = addString(sectionStrings, ".shstrtab");
+
+  const auto numLocalSymbols = 2; // null symbol and .rodata section symbol
+  const auto symtabOffset = alignTo(rodataOffset + rodataSize, wordAlignment);
+  const auto symtabSize = int64{symbolSize} * (numLocalSymbols + symbols.size());
+  const auto strtabOffset = symtabOffset + symtabSize;
+  const auto strtabSize = static_cast<int64>(symbolStrings.getDataSize());
+  const auto shstrtabOffset = strtabOffset + strtabSize;
+  const auto shstrtabSize = static_cast<int64>(sectionStrings.getDataSize());
+  const auto sectionHeadersOffset = alignTo(shstrtabOffset + shstrtabSize, wordAlignment);
+
+  TemporaryFile temporaryFile{objectFile};
+
+  {
+    FileOutputStream fileStream{temporaryFile.getFile()};
+    if (!fileStream.openedOk())
+    {
+      return Result::fail("Can't write to file: " + objectFile.getFullPathName());
+    }
+
+    ElfOutputStream elf{fileStream, is64Bit};
+
+    // ELF header
+    const char identification[16] = {
+      0x7f, 'E', 'L', 'F', static_cast<char>(is64Bit ? 2 : 1), 1, 1};
+    fileStream.write(identification, sizeof(identification));
+    elf.writeHalf(relocatableFileType);
+    elf.writeHalf(machine->elfMachine);
+    elf.writeWord(1); // e_version
+    elf.writeAddress(0); // e_entry
+    elf.writeAddress(0); // e_phoff
+    elf.writeAddress(sectionHeadersOffset);
+    elf.writeWord(0); // e_flags
+    elf.writeHalf(headerSize);
+    elf.writeHalf(0); // e_phentsize
+    elf.writeHalf(0); // e_phnum
+    elf.writeHalf(sectionHeaderSize);
+    elf.writeHalf(numSections);
+    elf.writeHalf(shstrtabSection);
+
+    // .rodata
+    elf.writePadding(rodataAlignment);
+    for (const auto& resourceFile : resourceFiles)
+    {
+      FileInputStream resourceStream{resourceFile};
+      const auto size = resourceFile.getSize();
+      if (!resourceStream.openedOk()
+          || fileStream.writeFromInputStream(resourceStream, -1) != size)
+      {
+        return Result::fail("Can't read resource file: "
+                            + resourceFile.getFullPathName());
+      }
+      elf.writeByte(0);
+      elf.writePadding(dataAlignment);
+    }
+
+    // .symtab
+    elf.writePadding(wordAlignment);
+    elf.writeSymbol(0, localSymbolBinding, 0, 0, nullSection, 0, 0);
+    elf.writeSymbol(0, localSymbolBinding, sectionSymbolType, 0, rodataSection, 0, 0);
+    for (auto i = 0; i < symbols.size(); ++i)
+    {
+      elf.writeSymbol(symbolNames[i], globalSymbolBinding, objectSymbolType,
+                      hiddenSymbolVisibility, rodataSection, dataOffsets[i],
+                      resourceFiles.getReference(i).getSize());
+    }
+
+    // .strtab and .shstrtab
+    fileStream << symbolStrings;
+    fileStream << sectionStrings;
+
+    // Section headers
+    elf.writePadding(wordAlignment);
+    elf.writeSectionHeader(0, 0, 0, 0, 0, 0, 0, 0, 0);
+    elf.writeSectionHeader(rodataName, progbitsSectionType, allocSectionFlag,
+                           rodataOffset, rodataSize, 0, 0, rodataAlignment, 0);
+    elf.writeSectionHeader(noteGnuStackName, progbitsSectionType, 0, sectionHeadersOffset,
+                           0, 0, 0, 1, 0);
+    elf.writeSectionHeader(symtabName, symtabSectionType, 0, symtabOffset, symtabSize,
+                           strtabSection, numLocalSymbols, wordAlignment, symbolSize);
+    elf.writeSectionHeader(strtabName, strtabSectionType, 0, strtabOffset, strtabSize, 0,
+                           0, 1, 0);
+    elf.writeSectionHeader(shstrtabName, strtabSectionType, 0, shstrtabOffset,
+                           shstrtabSize, 0, 0, 1, 0);
+
+    fileStream.flush();
+    if (fileStream.getStatus().failed())
+    {
+      return Result::fail("Can't write to file: " + objectFile.getFullPathName());
+    }
+  }
+
+  // Like FileHelpers::overwriteFileWithNewDataIfDifferent(), so that the target is only
+  // linked again when a resource file changed
+  if (objectFile.hasIdenticalContentTo(temporaryFile.getFile()))
+  {
+    return Result::ok();
+  }
+
+  if (!temporaryFile.overwriteTargetFileWithTemporary())
+  {
+    return Result::fail("Can't write to file: " + objectFile.getFullPathName());
+  }
+
+  return Result::ok();
+}
+
+} // namespace ElfObjectWriter
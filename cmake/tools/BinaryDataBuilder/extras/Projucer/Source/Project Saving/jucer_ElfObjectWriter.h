@@ -0,0 +1,38 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+
+// Writes a relocatable ELF object file containing the content of each resource file in
+// its .rodata section, followed by a null byte. Each resource file gets a global symbol
+// with hidden visibility, so that the content can be referenced from C++ code without
+// being exported from shared libraries. The content of each resource file is aligned to
+// dataAlignment bytes, and padded with null bytes to a multiple of it.
+namespace ElfObjectWriter
+{
+
+// Returns true if machine is one of "x86", "x86_64" or "arm64"
+bool isSupportedMachine(const String& machine);
+
+Result write(const File& objectFile,
+             const String& machine,
+             const Array<File>& resourceFiles,
+             const StringArray& symbols,
+             int dataAlignment = 1);
+
+} // namespace ElfObjectWriter
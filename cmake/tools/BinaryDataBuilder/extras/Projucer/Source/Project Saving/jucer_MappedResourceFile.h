@@ -0,0 +1,52 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+
+// Read-only view of the content of a resource file. The resource file is memory-mapped
+// instead of being loaded in a MemoryBlock, so that resource files of several GB can be
+// encoded without having to fit in memory.
+class MappedResourceFile
+{
+public:
+  explicit MappedResourceFile(const File& file)
+    : mappedFile{file, MemoryMappedFile::readOnly}
+    , isEmptyFile{file.existsAsFile() && file.getSize() == 0}
+  {
+  }
+
+  // MemoryMappedFile can't map empty files, so they are handled separately
+  bool openedOk() const
+  {
+    return isEmptyFile || mappedFile.getData() != nullptr;
+  }
+
+  const void* getData() const
+  {
+    return isEmptyFile ? nullptr : mappedFile.getData();
+  }
+
+  size_t getSize() const
+  {
+    return isEmptyFile ? 0 : mappedFile.getSize();
+  }
+
+private:
+  const MemoryMappedFile mappedFile;
+  const bool isEmptyFile;
+};
@@ -0,0 +1,132 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../jucer_Headers.h"
+#include "jucer_PackFileWriter.h"
+
+#include "../Utility/jucer_ContentHash.h"
+
+
+namespace PackFileWriter
+{
+
+namespace
+{
+
+int64 alignTo(int64 offset, int64 alignment)
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+
+Result write(const File& packFile,
+             const Array<File>& resourceFiles,
+             int dataAlignment,
+             uint64& packId)
+{
+  // The pack file is memory-mapped at a page boundary, so the offsets are enough to align
+  // the data
+  dataAlignment = jmax(16, dataAlignment);
+
+  const auto numEntries = resourceFiles.size();
+
+  const auto dataOffset =
+    alignTo(int64{headerSize} + int64{entrySize} * numEntries, dataAlignment);
+
+  MemoryOutputStream entries;
+  auto offset = dataOffset;
+
+  for (auto i = 0; i < numEntries; ++i)
+  {
+    const auto& resourceFile = resourceFiles.getReference(i);
+    if (!resourceFile.existsAsFile())
+    {
+      return Result::fail("Can't open resource file: " + resourceFile.getFullPathName());
+    }
+
+    const auto size = resourceFile.getSize();
+
+    entries.writeInt64(offset);
+    entries.writeInt64(size);
+
+    offset = alignTo(offset + size + 1, dataAlignment);
+  }
+
+  packId = ContentHash::compute(entries.getData(), entries.getDataSize());
+
+  TemporaryFile temporaryFile{packFile};
+
+  {
+    FileOutputStream out{temporaryFile.getFile()};
+    if (!out.openedOk())
+    {
+      return Result::fail("Can't write to file: " + packFile.getFullPathName());
+    }
+
+    const auto writePadding = [&out](int64 alignment) {
+      while (out.getPosition() % alignment != 0)
+      {
+        out.writeByte(0);
+      }
+    };
+
+    out.write("FRUTPACK", 8);
+    out.writeInt(version);
+    out.writeInt(numEntries);
+    out.writeInt64(static_cast<int64>(packId));
+
+    out << entries;
+
+    writePadding(dataAlignment);
+
+    for (const auto& resourceFile : resourceFiles)
+    {
+      FileInputStream resourceStream{resourceFile};
+      if (!resourceStream.openedOk()
+          || out.writeFromInputStream(resourceStream, -1) != resourceFile.getSize())
+      {
+        return Result::fail("Can't read resource file: " + resourceFile.getFullPathName());
+      }
+      out.writeByte(0);
+      writePadding(dataAlignment);
+    }
+
+    out.flush();
+    if (out.getStatus().failed())
+    {
+      return Result::fail("Can't write to file: " + packFile.getFullPathName());
+    }
+  }
+
+  // Like FileHelpers::overwriteFileWithNewDataIfDifferent(), so that the pack file is only
+  // copied again when a resource file changed
+  if (packFile.hasIdenticalContentTo(temporaryFile.getFile()))
+  {
+    return Result::ok();
+  }
+
+  if (!temporaryFile.overwriteTargetFileWithTemporary())
+  {
+    return Result::fail("Can't write to file: " + packFile.getFullPathName());
+  }
+
+  return Result::ok();
+}
+
+} // namespace PackFileWriter
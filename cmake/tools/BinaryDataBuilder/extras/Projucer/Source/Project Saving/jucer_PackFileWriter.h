@@ -0,0 +1,45 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+
+// Writes a pack file containing the content of each resource file, which is memory-mapped
+// at runtime instead of being compiled in the binary. All integers are little-endian:
+//
+// - header (24 bytes): "FRUTPACK", uint32 version, uint32 number of entries and uint64
+//   pack id
+// - entries (16 bytes each): uint64 offset of the data and uint64 size of the data
+// - data: the content of each resource file followed by a null byte, aligned to 16 bytes or
+//   dataAlignment bytes if greater, and padded with null bytes to a multiple of it
+//
+// The pack id is a hash of the entries, so that the code reading the pack file can check
+// that it was written for the same resource files. The entries are looked up by index, the
+// generated code maps the names of the resource files to them.
+namespace PackFileWriter
+{
+
+const auto version = 2;
+const auto headerSize = 24;
+const auto entrySize = 16;
+
+Result write(const File& packFile,
+             const Array<File>& resourceFiles,
+             int dataAlignment,
+             uint64& packId);
+
+} // namespace PackFileWriter
@@ -0,0 +1,164 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../jucer_Headers.h"
+#include "jucer_ParallelLiteralEncoder.h"
+
+#include <algorithm>
+#include <atomic>
+
+
+namespace
+{
+
+// At least one thread, and no more threads than items
+int getNumThreadsToUse(int numThreads, int numItems)
+{
+  return std::max(1, std::min(numThreads, numItems));
+}
+
+} // namespace
+
+
+Result parallelFor(int numThreads, int numItems,
+                   const std::function<Result(int index)>& function)
+{
+  std::vector<Result> results(static_cast<size_t>(std::max(0, numItems)), Result::ok());
+  std::atomic<int> nextIndex{0};
+
+  const auto processNextItems = [&]() {
+    for (auto i = nextIndex++; i < numItems; i = nextIndex++)
+    {
+      results[static_cast<size_t>(i)] = function(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (auto i = 1; i < getNumThreadsToUse(numThreads, numItems); ++i)
+  {
+    threads.emplace_back(processNextItems);
+  }
+
+  processNextItems();
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const auto& result : results)
+  {
+    if (result.failed())
+    {
+      return result;
+    }
+  }
+
+  return Result::ok();
+}
+
+
+ParallelLiteralEncoder::ParallelLiteralEncoder(int numFilesToEncode, int numThreads,
+                                               EncodeFunction encodeFunction)
+  : numFiles{numFilesToEncode}
+  , maxNumFilesAhead{2 * getNumThreadsToUse(numThreads, numFilesToEncode)}
+  , encode{std::move(encodeFunction)}
+{
+  for (auto i = 0; i < getNumThreadsToUse(numThreads, numFiles); ++i)
+  {
+    threads.emplace_back([this] { encodeFiles(); });
+  }
+}
+
+
+ParallelLiteralEncoder::~ParallelLiteralEncoder()
+{
+  {
+    const std::lock_guard<std::mutex> lock{mutex};
+    shouldStop = true;
+  }
+  condition.notify_all();
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+
+void ParallelLiteralEncoder::writeLiteral(int fileIndex, OutputStream& out)
+{
+  MemoryBlock literal;
+
+  {
+    std::unique_lock<std::mutex> lock{mutex};
+
+    // The literals of the resource files that were skipped are not needed anymore
+    literals.erase(literals.begin(), literals.lower_bound(fileIndex));
+    nextFileIndexToWrite = fileIndex;
+    condition.notify_all();
+
+    condition.wait(lock, [this, fileIndex] { return literals.count(fileIndex) != 0; });
+
+    literal.swapWith(literals[fileIndex]);
+    literals.erase(fileIndex);
+    nextFileIndexToWrite = fileIndex + 1;
+  }
+  condition.notify_all();
+
+  out.write(literal.getData(), literal.getSize());
+}
+
+
+void ParallelLiteralEncoder::encodeFiles()
+{
+  for (;;)
+  {
+    auto fileIndex = 0;
+
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+
+      condition.wait(lock, [this] {
+        return shouldStop || nextFileIndexToEncode >= numFiles
+               || nextFileIndexToEncode < nextFileIndexToWrite + maxNumFilesAhead;
+      });
+
+      if (shouldStop || nextFileIndexToEncode >= numFiles)
+      {
+        return;
+      }
+
+      fileIndex = nextFileIndexToEncode++;
+    }
+
+    MemoryBlock literal;
+    {
+      MemoryOutputStream literalStream{literal, false};
+      encode(fileIndex, literalStream);
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock{mutex};
+      if (fileIndex >= nextFileIndexToWrite)
+      {
+        literals[fileIndex].swapWith(literal);
+      }
+    }
+    condition.notify_all();
+  }
+}
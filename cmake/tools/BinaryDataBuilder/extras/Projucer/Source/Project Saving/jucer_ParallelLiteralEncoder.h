@@ -0,0 +1,67 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Calls function for each index in [0, numItems) on at most numThreads threads, including
+// the calling one, and returns the failed Result with the lowest index, if any. The indices
+// are handed out one at a time, so function must only write data at its index.
+Result parallelFor(int numThreads, int numItems,
+                   const std::function<Result(int index)>& function);
+
+
+// Encodes the C++ literals of the resource files on several threads, ahead of the
+// resource file being written, so that the resource files can still be written one after
+// the other in the same order.
+//
+// At most two literals per thread are kept in memory, so that memory usage doesn't
+// depend on the number of resource files.
+class ParallelLiteralEncoder
+{
+public:
+  using EncodeFunction = std::function<void(int fileIndex, OutputStream&)>;
+
+  ParallelLiteralEncoder(int numFiles, int numThreads, EncodeFunction encodeFunction);
+  ~ParallelLiteralEncoder();
+
+  // fileIndex must be greater than the one of the previous call
+  void writeLiteral(int fileIndex, OutputStream& out);
+
+private:
+  void encodeFiles();
+
+  const int numFiles;
+  const int maxNumFilesAhead;
+  const EncodeFunction encode;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  int nextFileIndexToEncode = 0;
+  int nextFileIndexToWrite = 0;
+  bool shouldStop = false;
+  std::map<int, MemoryBlock> literals;
+
+  std::vector<std::thread> threads;
+};
@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2019  Alain Martin
+// Copyright (C) 2017-2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,13 +17,13 @@
 
 // clang-format off
 
-// Lines 30-97, 100-110, 114-128, 132-151, 154-161, 165-173, 177-244, 247-252, 255-271, and 275-289 of this file were copied from
+// Lines 30-56, 65-88, 90-92, 94-106, 109-116, 127, 131-141, 154-157, 161-173, 192-196, 200, 202-203, 216, 227, 231, 233, 235, 240, 257, 260, 269-295, 303-304, 306-317, 327-333, 1343-1346, 1394-1395, 1398-1406, 1426-1432, 1442, 1458-1462, 1464-1466, and 1484-1485 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/4.2.0/extras/Projucer/Source/Project%20Saving/jucer_ResourceFile.cpp
 
-// Lines 292-316, 320-326, 330-344, and 348-365 of this file were copied from
+// Lines 1488-1512, 1516-1519, 1530, 1534-1544, 1557-1560, 1564-1576, and 1595-1597 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/5.0.0/extras/Projucer/Source/Project%20Saving/jucer_ResourceFile.cpp
 
-// Lines 368-392, 396-402, 406-420, 424-448, 452-458, 462-470, and 474-559 of this file were copied from
+// Lines 1600-1624, 1628-1631, 1642, 1646-1656, 1669-1672, 1676-1695, 1714-1716, 1720, 1722-1723, 1736, 1747, 1751, 1753, 1755, 1760, 1777, 1780, 1789-1811, 1814, 1816, 1824-1825, 1827-1843, 1846-1859, and 1869-1874 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/5.3.2/extras/Projucer/Source/ProjectSaving/jucer_ResourceFile.cpp
 
 
@@ -54,199 +54,1342 @@
 #include "../jucer_Headers.h"
 #include "jucer_ResourceFile.h"
 
+#include "jucer_ElfObjectWriter.h"
+#include "jucer_MappedResourceFile.h"
+#include "jucer_PackFileWriter.h"
+#include "../Utility/jucer_ContentHash.h"
+
+#include <algorithm>
+#include <map>
+
 static const char* resourceFileIdentifierString = "JUCER_BINARY_RESOURCE";
 
 
-//==============================================================================
-ResourceFile::ResourceFile (Project& p)
-    : project (p),
-      className ("BinaryData")
-{
+//==============================================================================
+ResourceFile::ResourceFile (Project& p)
+    : project (p),
+      className ("BinaryData")
+{
+}
+
+//==============================================================================
+void ResourceFile::setClassName (const String& name)
+{
+    className = name;
+}
+
+void ResourceFile::addFile (const File& file)
+{
+    files.add (file);
+
+    const String variableNameRoot (CodeHelpers::makeBinaryDataIdentifierName (file));
+    String variableName (variableNameRoot);
+
+    int suffix = 2;
+    while (usedVariableNames.count (variableName) != 0)
+        variableName = variableNameRoot + String (suffix++);
+
+    variableNames.add (variableName);
+    usedVariableNames.insert (variableName);
+}
+
+static String getComment()
+{
+    String comment;
+    comment << newLine << newLine
+            << "   This is an auto-generated file: Any edits you make may be overwritten!" << newLine
+            << newLine
+            << "*/" << newLine
+            << newLine;
+
+    return comment;
+}
+
+template <ProjucerVersion>
+Result ResourceFile::writeHeader (MemoryOutputStream& header)
+{
+    const String headerGuard ("BINARYDATA_H_" + String (project.getProjectUID().hashCode() & 0x7ffffff) + "_INCLUDED");
+
+    header << "/* ========================================================================================="
+           << getComment()
+           << "#ifndef " << headerGuard << newLine
+           << "#define " << headerGuard << newLine
+           << newLine;
+
+    if (useConstexprIndex)
+        writeConstexprIndexIncludes (header);
+
+    if (hasDecodedImages)
+        header << "namespace juce { class Image; }" << newLine
+               << newLine;
+
+    header << "namespace " << className << newLine
+           << "{" << newLine;
+
+    // bool containsAnyImages = false;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        const File& file = files.getReference(i);
+
+        if (! file.existsAsFile())
+            return Result::fail ("Can't open resource file: " + file.getFullPathName());
+
+        const int64 dataSize = file.getSize();
+
+        const String variableName (variableNames[i]);
+
+        if (isCompressed (i))
+        {
+            writeCompressedResourceDeclaration (i, header);
+            continue;
+        }
+
+        if (backend == BinaryDataBackend::pack)
+        {
+            writePackResourceDeclaration (i, header);
+            continue;
+        }
+
+        FileInputStream fileStream (file);
+
+        if (fileStream.openedOk())
+        {
+            // containsAnyImages = containsAnyImages
+            //                      || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
+
+            header << "    extern const char*   " << variableName << ";" << newLine;
+            header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
+        }
+    }
+
+    header << "    // Points to the start of a list of resource names." << newLine
+           << "    extern const char* namedResourceList[];" << newLine
+           << newLine
+           << "    // Number of elements in the namedResourceList array." << newLine
+           << "    const int namedResourceListSize = " << files.size() <<  ";" << newLine
+           << newLine
+           << "    // If you provide the name of one of the binary resource variables above, this function will" << newLine
+           << "    // return the corresponding data and its size (or a null pointer if the name isn't found)." << newLine
+           << "    const char* getNamedResource (const char* resourceNameUTF8, int& dataSizeInBytes) throw();" << newLine;
+
+    if (compressResources)
+        writeCompressionFunctionDeclarations (header);
+
+    if (alignment > 1)
+        writeAlignmentDeclarations (header);
+
+    if (useConstexprIndex && ! files.isEmpty())
+        writeConstexprIndex (header);
+
+    if (emitContentHashes)
+        writeContentHashDeclarations (header);
+
+    if (hasDecodedImages)
+        writeDecodedImageFunctionDeclaration (header);
+
+    header << "}" << newLine
+           << newLine
+           << "#endif" << newLine;
+
+    return Result::ok();
+}
+
+template <ProjucerVersion>
+Result ResourceFile::writeCpp (OutputStream& cpp, const File& headerFile, int& i, const int maxFileSize)
+{
+    const bool isFirstFile = (currentCppFileIndex == 0);
+
+    cpp << "/* ==================================== " << resourceFileIdentifierString << " ===================================="
+        << getComment();
+
+    // The compressed resources are decompressed, and the pack file is memory-mapped, with
+    // juce_core, and the decoded images are copied to juce::Image objects
+    if (isFirstFile && (compressResources || backend == BinaryDataBackend::pack || hasDecodedImages))
+        cpp << "#include \"JuceHeader.h\"" << newLine
+            << newLine
+            << "#include <memory>" << newLine
+            << "#include <mutex>" << newLine
+            << newLine;
+
+    cpp << "namespace " << className << newLine
+        << "{" << newLine;
+
+    if (backend == BinaryDataBackend::incbin)
+        writeIncbinMacros (cpp);
+
+    if (backend == BinaryDataBackend::pack && ! files.isEmpty())
+        writePackLoader (cpp);
+
+    // bool containsAnyImages = false;
+
+    while (i < files.size() && ! isCppFileFull (cpp, i, maxFileSize))
+    {
+        const int fileIndex = getFileIndex (i);
+        const File& file = files.getReference(fileIndex);
+        const String variableName (getDataVariableName (fileIndex));
+
+        FileInputStream fileStream (getDataFile (fileIndex));
+
+        if (fileStream.openedOk() && ! isDuplicate (fileIndex))
+        {
+            // containsAnyImages = containsAnyImages
+            //                      || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
+
+            const String tempVariable (getTempVariableName (fileIndex));
+
+            if (backend == BinaryDataBackend::incbin)
+            {
+                writeIncbinData (file, getDataFile (fileIndex), tempVariable, cpp);
+            }
+            else if (backend == BinaryDataBackend::elfObject)
+            {
+                writeElfObjectDataDeclaration (file, tempVariable, cpp);
+            }
+            else if (backend == BinaryDataBackend::pack)
+            {
+                writePackDataDeclaration (file, fileIndex, cpp);
+            }
+            else
+            {
+                cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
+                    << getAlignmentSpecifier() << "static const unsigned char " << tempVariable << "[" << getPaddedArraySize (fileIndex) << "] =" << newLine;
+
+                writeDataAsCppLiteral (i, cpp);
+            }
+
+            // The resources of the pack file are functions, written by writePackDataDeclaration()
+            if (backend != BinaryDataBackend::pack)
+            {
+                cpp << newLine << newLine
+                    << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
+
+                writeDuplicateDefinitions (fileIndex, tempVariable, cpp);
+            }
+        }
+
+        ++i;
+    }
+
+    if (isFirstFile)
+    {
+        if (i < files.size())
+        {
+            cpp << newLine
+                << "}" << newLine
+                << newLine
+                << "#include \"" << headerFile.getFileName() << "\"" << newLine
+                << newLine
+                << "namespace " << className << newLine
+                << "{";
+        }
+
+        cpp << newLine
+            << newLine
+            << "const char* getNamedResource (const char*, int&) throw();" << newLine
+            << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes) throw()" << newLine
+            << "{" << newLine;
+
+        StringArray returnCodes;
+        for (int j = 0; j < files.size(); ++j)
+        {
+            if (isCompressed (j))
+            {
+                returnCodes.add ("numBytes = 0; return 0;");
+                continue;
+            }
+
+            returnCodes.add (getNamedResourceReturnCode (j));
+        }
+
+        writeStringMatcher (cpp, variableNames, returnCodes);
+
+        cpp << "    numBytes = 0;" << newLine
+            << "    return 0;" << newLine
+            << "}" << newLine
+            << newLine
+            << "const char* namedResourceList[] =" << newLine
+            << "{" << newLine;
+
+        for (int j = 0; j < files.size(); ++j)
+            cpp << "    " << variableNames[j].quoted() << (j < files.size() - 1 ? "," : "") << newLine;
+
+        cpp << "};" << newLine;
+
+        if (compressResources)
+            writeCompressionFunctions (cpp);
+
+        if (hasDecodedImages)
+            writeDecodedImageFunction (cpp);
+
+        if (emitContentHashes)
+            writeContentHashFunction (cpp);
+    }
+
+    cpp << newLine
+        << "}" << newLine;
+
+    return Result::ok();
+}
+
+//==============================================================================
+Array<int> ResourceFile::computeShardPlan (const int maxFileSize) const
+{
+    if (numShards > 0)
+    {
+        // The first BinaryData.cpp file only contains the lookup functions
+        Array<int> plan;
+        plan.insertMultiple (0, 0, numShards + 1);
+
+        for (int i = 0; i < files.size(); ++i)
+            ++plan.getReference (1 + getShardIndex (i));
+
+        return plan;
+    }
+
+    if (backend == BinaryDataBackend::elfObject || backend == BinaryDataBackend::pack)
+    {
+        Array<int> plan;
+        plan.add (files.size());
+        return plan;
+    }
+
+    if (backend == BinaryDataBackend::incbin)
+    {
+        Array<int> plan;
+
+        for (int i = 0; i < jmax (1, files.size()); ++i)
+            plan.add (1);
+
+        return plan;
+    }
+
+    // Upper bound of the number of bytes that writeCpp() writes for a resource file:
+    // string literals (only used below 32768 bytes) can take up to 8 characters per byte
+    // when breaking at new lines, and comma-separated numbers up to 4 characters per byte
+    // plus line breaks.
+    auto estimateCppSize = [this] (int fileIndex)
+    {
+        const auto& file = files.getReference (fileIndex);
+        const auto dataSize = file.getSize();
+        const auto literalSize = dataSize < 32768 ? dataSize * 8 : dataSize * 4 + dataSize / 50;
+
+        return (int64) 128 + 2 * file.getFileName().length()
+                 + 2 * variableNames[fileIndex].length() + literalSize;
+    };
+
+    const int64 preambleSize = 256 + className.length();
+
+    Array<int> plan;
+    int64 position = preambleSize;
+    int numFilesInCppFile = 0;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        position += estimateCppSize (i);
+        ++numFilesInCppFile;
+
+        if (position > maxFileSize)
+        {
+            plan.add (numFilesInCppFile);
+            position = preambleSize;
+            numFilesInCppFile = 0;
+        }
+    }
+
+    if (numFilesInCppFile > 0 || plan.isEmpty())
+        plan.add (numFilesInCppFile);
+
+    return plan;
+}
+
+Result ResourceFile::setShardPlan (const Array<int>& numFilesPerCppFile)
+{
+    // The shards only depend on the file names of the resource files, but empty shards are
+    // still written, so that the BinaryData.cpp files don't change when one of them gets
+    // empty
+    if (numShards > 0)
+    {
+        if (numFilesPerCppFile != computeShardPlan (0))
+            return Result::fail ("The shard plan doesn't match the resource files, re-run CMake to update it");
+
+        shardPlan = numFilesPerCppFile;
+        return Result::ok();
+    }
+
+    int numFiles = 0;
+
+    for (auto n : numFilesPerCppFile)
+    {
+        if (n <= 0)
+            return Result::fail ("Invalid shard plan, each BinaryData.cpp file must contain at least one resource");
+
+        numFiles += n;
+    }
+
+    if (numFiles != files.size())
+        return Result::fail ("The shard plan doesn't match the resource files, re-run CMake to update it");
+
+    shardPlan = numFilesPerCppFile;
+    return Result::ok();
+}
+
+bool ResourceFile::isCppFileFull (OutputStream& cpp, const int numFilesWritten, const int maxFileSize) const
+{
+    if (shardPlan.isEmpty())
+        return numFilesWritten > firstWriteIndexInCppFile && cpp.getPosition() > maxFileSize;
+
+    int end = 0;
+
+    for (int j = 0; j <= currentCppFileIndex && j < shardPlan.size(); ++j)
+        end += shardPlan[j];
+
+    return numFilesWritten >= end;
+}
+
+// Rendezvous hashing: each resource file goes to the shard with the highest hash of its file
+// name seeded with the shard index. Unlike a modulo, changing the number of shards from N to
+// N + 1 only moves about 1 / (N + 1) of the resource files, to the new shard.
+int ResourceFile::getShardIndex (const int fileIndex) const
+{
+    const String fileName (files.getReference (fileIndex).getFileName());
+
+    int shardIndex = 0;
+    uint64 highestHash = 0;
+
+    for (int shard = 0; shard < numShards; ++shard)
+    {
+        const uint64 hash = ContentHash::compute (fileName.toRawUTF8(), fileName.getNumBytesAsUTF8(), (uint64) shard);
+
+        if (shard == 0 || hash > highestHash)
+        {
+            shardIndex = shard;
+            highestHash = hash;
+        }
+    }
+
+    return shardIndex;
+}
+
+int ResourceFile::getFileIndex (const int writeIndex) const
+{
+    return fileOrder.isEmpty() ? writeIndex : fileOrder[writeIndex];
+}
+
+// With shards, the temporary variables are named after the resource files instead of their
+// indices, so that adding or removing a resource file doesn't change the other shards
+String ResourceFile::getTempVariableName (const int fileIndex) const
+{
+    return "temp_binary_data_" + (numShards > 0 ? variableNames[fileIndex] : String (fileIndex));
+}
+
+void ResourceFile::setCacheDirectory (const File& cacheDirectory)
+{
+    cache.reset (new ResourceFileCache (cacheDirectory));
+}
+
+void ResourceFile::setNumberOfShards (const int n)
+{
+    numShards = jmax (0, n);
+}
+
+void ResourceFile::setDeduplicateResources (const bool shouldDeduplicateResources)
+{
+    deduplicateResources = shouldDeduplicateResources;
+}
+
+void ResourceFile::setNumberOfThreads (const int n)
+{
+    numThreads = jmax (1, n);
+}
+
+void ResourceFile::setBackend (const BinaryDataBackend b)
+{
+    backend = b;
+}
+
+void ResourceFile::setElfMachine (const String& machine)
+{
+    elfMachine = machine;
+}
+
+void ResourceFile::setAlignment (const int newAlignment)
+{
+    jassert (isPowerOfTwo (newAlignment) && newAlignment <= maxAlignment);
+    alignment = newAlignment;
+}
+
+// An empty string when the data doesn't have to be aligned, so that the generated code
+// stays the same as Projucer's
+String ResourceFile::getAlignmentSpecifier() const
+{
+    return alignment > 1 ? "alignas (" + String (alignment) + ") " : String();
+}
+
+// CodeHelpers::writeDataAsCppLiteral() writes up to two null bytes after the data, and the
+// remaining elements of the array are zero-initialized
+String ResourceFile::getPaddedArraySize (const int fileIndex) const
+{
+    if (alignment <= 1)
+        return {};
+
+    const int64 size = getDataFile (fileIndex).getSize() + 2;
+    return String ((size + alignment - 1) / alignment * alignment);
+}
+
+void ResourceFile::writeAlignmentDeclarations (OutputStream& out) const
+{
+    out << newLine
+        << "    // The data of each binary resource (but not the data returned by getUncompressedNamedResource())" << newLine
+        << "    // is aligned to resourceAlignment bytes, and padded with null bytes to a multiple of" << newLine
+        << "    // resourceAlignment bytes, so that it can be read with aligned SIMD loads. Code relying on it" << newLine
+        << "    // can check it when compiling, for instance with:" << newLine
+        << "    //     static_assert (" << className << "::resourceAlignment >= 16, \"SIMD loads need 16 bytes\");" << newLine
+        << "    constexpr int resourceAlignment = " << alignment << ";" << newLine
+        << newLine
+        << "    // The data of the binary resources is declared with alignas (resourceAlignment), so this fails to" << newLine
+        << "    // compile if the compiler can't honour it." << newLine
+        << "    struct alignas (resourceAlignment) AlignedResourceData { unsigned char bytes[resourceAlignment]; };" << newLine
+        << "    static_assert ((resourceAlignment & (resourceAlignment - 1)) == 0" << newLine
+        << "                   && alignof (AlignedResourceData) == resourceAlignment" << newLine
+        << "                   && sizeof (AlignedResourceData) == resourceAlignment," << newLine
+        << "                   \"The binary resources can't be aligned to resourceAlignment bytes\");" << newLine;
+}
+
+void ResourceFile::setUseConstexprIndex (const bool shouldUseConstexprIndex)
+{
+    useConstexprIndex = shouldUseConstexprIndex;
+}
+
+void ResourceFile::writeConstexprIndexIncludes (OutputStream& out) const
+{
+    out << "#include <cstdint>" << newLine
+        << "#include <string_view>" << newLine
+        << newLine;
+}
+
+void ResourceFile::writeConstexprIndex (OutputStream& out) const
+{
+    out << newLine
+        << "    // Describes a binary resource at compile time. contentHash is the xxHash64 of its content, and" << newLine
+        << "    // data points to its variable (or is a null pointer if the resource is compressed, or stored in" << newLine
+        << "    // the pack file)." << newLine
+        << "    struct ResourceInfo" << newLine
+        << "    {" << newLine
+        << "        std::string_view name;" << newLine
+        << "        std::string_view originalFilename;" << newLine
+        << "        int size;" << newLine
+        << "        std::uint64_t contentHash;" << newLine
+        << "        const char* const* data;" << newLine
+        << "    };" << newLine
+        << newLine
+        << "    inline constexpr ResourceInfo resourceIndex[] =" << newLine
+        << "    {" << newLine;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        const File& file = files.getReference (i);
+
+        out << "        { " << variableNames[i].quoted() << ", " << file.getFileName().quoted() << ", "
+            << (int) file.getSize() << ", 0x" << ContentHash::toHexString (contentHashes[i]) << "ull, "
+            << (isCompressed (i) || backend == BinaryDataBackend::pack ? String ("nullptr") : "&" + variableNames[i]) << " }"
+            << (i < files.size() - 1 ? "," : "") << newLine;
+    }
+
+    out << "    };" << newLine
+        << newLine
+        << "    // Called by getResourceInfo() when the name isn't found. As it isn't constexpr, an unknown" << newLine
+        << "    // name fails to compile when getResourceInfo() is evaluated at compile time." << newLine
+        << "    inline const ResourceInfo& unknownResource (std::string_view)" << newLine
+        << "    {" << newLine
+        << "        static const ResourceInfo noResource { {}, {}, 0, 0, nullptr };" << newLine
+        << "        return noResource;" << newLine
+        << "    }" << newLine
+        << newLine
+        << "    // Returns the ResourceInfo of the resource with the given name (the name of its variable)." << newLine
+        << "    // Evaluate it at compile time to resolve the name when building, for instance with:" << newLine
+        << "    //     constexpr auto& info = " << className << "::getResourceInfo (\"" << variableNames[0] << "\");" << newLine
+        << "    constexpr const ResourceInfo& getResourceInfo (std::string_view resourceName)" << newLine
+        << "    {" << newLine
+        << "        for (const auto& resource : resourceIndex)" << newLine
+        << "            if (resource.name == resourceName)" << newLine
+        << "                return resource;" << newLine
+        << newLine
+        << "        return unknownResource (resourceName);" << newLine
+        << "    }" << newLine;
+}
+
+void ResourceFile::setEmitContentHashes (const bool shouldEmitContentHashes)
+{
+    emitContentHashes = shouldEmitContentHashes;
+}
+
+// The content of each resource file is hashed once, before writing anything, since the
+// hashes are needed by BinaryData.h
+Result ResourceFile::computeContentHashes()
+{
+    contentHashes.clearQuick();
+    contentHashes.insertMultiple (0, 0, files.size());
+
+    // Each thread only writes the elements of contentHashes at the indices it gets
+    return parallelFor (numThreads, files.size(), [this] (int i)
+    {
+        const File& file = files.getReference (i);
+        const MappedResourceFile data (file);
+
+        if (! data.openedOk())
+            return Result::fail ("Can't open resource file: " + file.getFullPathName());
+
+        contentHashes.getReference (i) = ContentHash::compute (data.getData(), data.getSize());
+        return Result::ok();
+    });
+}
+
+// Hashes the names and the content hashes of all the resource files, so that renaming,
+// adding or removing a resource file changes it as well
+uint64 ResourceFile::getAggregateContentHash() const
+{
+    MemoryOutputStream names;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        names << variableNames[i];
+        names.writeByte (0);
+        names.writeInt64 ((int64) contentHashes[i]);
+    }
+
+    return ContentHash::compute (names.getData(), names.getDataSize());
+}
+
+void ResourceFile::writeContentHashDeclarations (OutputStream& out) const
+{
+    out << newLine
+        << "    // The xxHash64 of the content of each binary resource, computed when building. They can be" << newLine
+        << "    // compared to a value stored on disk to find out whether data derived from a resource is" << newLine
+        << "    // still valid, without hashing the resource at runtime." << newLine;
+
+    for (int i = 0; i < files.size(); ++i)
+        out << "    const unsigned long long " << variableNames[i] << "ContentHash = 0x" << ContentHash::toHexString (contentHashes[i]) << "ull;" << newLine;
+
+    out << newLine
+        << "    // Changes whenever a binary resource is added, removed, renamed or modified." << newLine
+        << "    const unsigned long long allResourcesContentHash = 0x" << ContentHash::toHexString (getAggregateContentHash()) << "ull;" << newLine
+        << newLine
+        << "    // If you provide the name of one of the binary resource variables above, this function will" << newLine
+        << "    // return the xxHash64 of its content (or 0 if the name isn't found)." << newLine
+        << "    unsigned long long getNamedResourceContentHash (const char* resourceNameUTF8);" << newLine;
+}
+
+void ResourceFile::writeContentHashFunction (OutputStream& out) const
+{
+    StringArray returnCodes;
+
+    for (int i = 0; i < files.size(); ++i)
+        returnCodes.add ("return " + variableNames[i] + "ContentHash;");
+
+    out << newLine
+        << "unsigned long long getNamedResourceContentHash (const char* resourceNameUTF8)" << newLine
+        << "{" << newLine;
+
+    writeStringMatcher (out, variableNames, returnCodes);
+
+    out << "    return 0;" << newLine
+        << "}" << newLine;
+}
+
+void ResourceFile::setHasDecodedImages (const bool resourceFilesHaveDecodedImages)
+{
+    hasDecodedImages = resourceFilesHaveDecodedImages;
+}
+
+void ResourceFile::writeDecodedImageFunctionDeclaration (OutputStream& out) const
+{
+    out << newLine
+        << "    // If you provide the name of one of the binary resource variables above that contains an image" << newLine
+        << "    // decoded when building, this function will return it as a juce::Image without decoding it" << newLine
+        << "    // again (or an invalid image if the name isn't found or isn't a decoded image)." << newLine
+        << "    juce::Image getDecodedImage (const char* resourceNameUTF8);" << newLine;
+}
+
+// Same as DecodedImage::read() in ImageDecoder, the pixels are copied so that the image can
+// be modified like any other juce::Image
+void ResourceFile::writeDecodedImageFunction (OutputStream& out) const
+{
+    out << newLine
+        << "juce::Image getDecodedImage (const char* resourceNameUTF8)" << newLine
+        << "{" << newLine
+        << "    const int headerSize = 24;" << newLine
+        << "    int dataSize = 0;" << newLine
+        << "    const char* data = " << (compressResources ? "getUncompressedNamedResource" : "getNamedResource") << " (resourceNameUTF8, dataSize);" << newLine
+        << newLine
+        << "    if (data == nullptr || dataSize < headerSize || memcmp (data, \"FRUTIMG1\", 8) != 0)" << newLine
+        << "        return juce::Image();" << newLine
+        << newLine
+        << "    const int width = (int) juce::ByteOrder::littleEndianInt (data + 8);" << newLine
+        << "    const int height = (int) juce::ByteOrder::littleEndianInt (data + 12);" << newLine
+        << "    const int stride = (int) juce::ByteOrder::littleEndianInt (data + 16);" << newLine
+        << newLine
+        << "    if (width <= 0 || height <= 0 || stride < width * 4 || (juce::int64) stride * height > dataSize - headerSize)" << newLine
+        << "        return juce::Image();" << newLine
+        << newLine
+        << "    juce::Image image (juce::Image::ARGB, width, height, false);" << newLine
+        << "    const juce::Image::BitmapData bitmap (image, juce::Image::BitmapData::writeOnly);" << newLine
+        << newLine
+        << "    for (int y = 0; y < height; ++y)" << newLine
+        << "        memcpy (bitmap.getLinePointer (y), data + headerSize + (size_t) y * (size_t) stride, (size_t) width * 4);" << newLine
+        << newLine
+        << "    return image;" << newLine
+        << "}" << newLine;
+}
+
+void ResourceFile::setCompressResources (const bool shouldCompressResources)
+{
+    compressResources = shouldCompressResources;
+}
+
+void ResourceFile::setUsePerfectHashLookup (const bool shouldUsePerfectHashLookup)
+{
+    usePerfectHashLookup = shouldUsePerfectHashLookup;
+}
+
+void ResourceFile::writeStringMatcher (OutputStream& out, const StringArray& strings, const StringArray& codeToExecute) const
+{
+    if (usePerfectHashLookup)
+        CodeHelpers::createPerfectHashStringMatcher (out, "resourceNameUTF8", strings, codeToExecute, 4);
+    else
+        CodeHelpers::createStringMatcher (out, "resourceNameUTF8", strings, codeToExecute, 4);
+}
+
+// Same as calling files.indexOf() for each file, without being quadratic
+Array<int> ResourceFile::getFirstFileIndices() const
+{
+    std::map<String, int> firstIndices;
+    Array<int> indices;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        auto path = files.getReference (i).getFullPathName();
+
+        if (! File::areFileNamesCaseSensitive())
+            path = path.toLowerCase();
+
+        indices.add (firstIndices.insert (std::make_pair (path, i)).first->second);
+    }
+
+    return indices;
+}
+
+// Already compressed resources (PNG, MP3, ZIP...) don't get much smaller, so they are
+// embedded as is instead of being decompressed at runtime for nothing
+static bool isWorthCompressing (const int64 originalSize, const int64 compressedSize)
+{
+    return compressedSize <= originalSize - originalSize / 8;
+}
+
+Result ResourceFile::compressFiles()
+{
+    compressedFiles.clearQuick();
+    compressedFiles.insertMultiple (0, File(), files.size());
+
+    if (files.isEmpty())
+        return Result::ok();
+
+    const File compressedFilesDir (project.getBinaryDataCompressedFile ({}).getParentDirectory());
+
+    if (! compressedFilesDir.createDirectory())
+        return Result::fail ("Can't create directory: " + compressedFilesDir.getFullPathName());
+
+    // The compressed files are named after the full paths and the content hashes of the
+    // resource files, so that they can't be mistaken for the compressed data of another
+    // resource file, or of a previous version of the same resource file (whatever its
+    // modification time)
+    Array<File> compressedFilesToUse;
+    compressedFilesToUse.insertMultiple (0, File(), files.size());
+
+    // Each thread only writes the elements of compressedFiles and compressedFilesToUse at the
+    // indices it gets
+    Result result (parallelFor (numThreads, files.size(), [this, &compressedFilesToUse] (int i)
+    {
+        const File& file = files.getReference (i);
+        const MappedResourceFile data (file);
+
+        if (! data.openedOk())
+            return Result::fail ("Can't open resource file: " + file.getFullPathName());
+
+        const File compressedFile (project.getBinaryDataCompressedFile (
+            file.getFileName() + "_" + String::toHexString (file.getFullPathName().hashCode64())
+              + "_" + ContentHash::toHexString (ContentHash::compute (data.getData(), data.getSize()))));
+        compressedFilesToUse.getReference (i) = compressedFile;
+
+        if (! compressedFile.existsAsFile())
+        {
+            TemporaryFile temporaryFile (compressedFile);
+            bool writtenOk = false;
+
+            {
+                FileOutputStream compressedData (temporaryFile.getFile());
+
+                if (compressedData.openedOk())
+                {
+                    {
+                        GZIPCompressorOutputStream compressor (&compressedData, 9);
+                        compressor.write (data.getData(), data.getSize());
+                    }
+
+                    compressedData.flush();
+                    writtenOk = compressedData.getStatus().wasOk();
+                }
+            }
+
+            if (! writtenOk || ! temporaryFile.overwriteTargetFileWithTemporary())
+                return Result::fail ("Can't write to file: " + compressedFile.getFullPathName());
+        }
+
+        if (isWorthCompressing (file.getSize(), compressedFile.getSize()))
+            compressedFiles.getReference (i) = compressedFile;
+
+        return Result::ok();
+    }));
+
+    if (result.failed())
+        return result;
+
+    // Remove the compressed data of the resource files that were removed from the project
+    Array<File> existingCompressedFiles;
+    compressedFilesDir.findChildFiles (existingCompressedFiles, File::findFiles, false, "*.zlib");
+
+    for (auto& existingCompressedFile : existingCompressedFiles)
+        if (! compressedFilesToUse.contains (existingCompressedFile))
+            existingCompressedFile.deleteFile();
+
+    return Result::ok();
+}
+
+// Resource files with the same content as a previous one are not embedded again, their
+// variables point to the data of the first one instead
+Result ResourceFile::findDuplicateFiles()
+{
+    duplicateFileIndices.clear();
+    originalFileIndices.clearQuick();
+    numDeduplicatedBytes = 0;
+
+    std::map<uint64, Array<int>> fileIndicesByContentHash;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        originalFileIndices.add (i);
+
+        if (! deduplicateResources)
+            continue;
+
+        const File dataFile (getDataFile (i));
+        const MappedResourceFile data (dataFile);
+
+        if (! data.openedOk())
+            return Result::fail ("Can't open resource file: " + dataFile.getFullPathName());
+
+        auto& candidates = fileIndicesByContentHash[ContentHash::compute (data.getData(), data.getSize())];
+
+        for (auto candidate : candidates)
+        {
+            // The content hashes are only 64-bit, so the content is compared as well
+            const MappedResourceFile candidateData (getDataFile (candidate));
+
+            if (candidateData.openedOk() && candidateData.getSize() == data.getSize()
+                 && (data.getSize() == 0 || memcmp (candidateData.getData(), data.getData(), data.getSize()) == 0))
+            {
+                originalFileIndices.set (i, candidate);
+                duplicateFileIndices[candidate].add (i);
+                numDeduplicatedBytes += (int64) data.getSize();
+                break;
+            }
+        }
+
+        if (! isDuplicate (i))
+            candidates.add (i);
+    }
+
+    return Result::ok();
+}
+
+bool ResourceFile::isDuplicate (const int fileIndex) const
+{
+    return fileIndex < originalFileIndices.size() && originalFileIndices[fileIndex] != fileIndex;
+}
+
+void ResourceFile::writeDuplicateDefinitions (const int fileIndex, const String& tempVariable, OutputStream& out) const
+{
+    auto duplicates = duplicateFileIndices.find (fileIndex);
+
+    if (duplicates == duplicateFileIndices.end())
+        return;
+
+    for (auto duplicate : duplicates->second)
+        out << "const char* " << getDataVariableName (duplicate) << " = (const char*) " << tempVariable << ";" << newLine;
+}
+
+int64 ResourceFile::getNumDeduplicatedBytes() const
+{
+    return numDeduplicatedBytes;
+}
+
+bool ResourceFile::isCompressed (const int fileIndex) const
+{
+    return fileIndex < compressedFiles.size() && compressedFiles.getReference (fileIndex) != File();
+}
+
+// The file whose content is embedded for the resource file at fileIndex
+File ResourceFile::getDataFile (const int fileIndex) const
+{
+    return isCompressed (fileIndex) ? compressedFiles.getReference (fileIndex) : files.getReference (fileIndex);
+}
+
+// Compressed resources get another variable name, so that code expecting the uncompressed
+// data doesn't compile
+String ResourceFile::getDataVariableName (const int fileIndex) const
+{
+    return variableNames[fileIndex] + (isCompressed (fileIndex) ? "Compressed" : "");
+}
+
+void ResourceFile::writeCompressedResourceDeclaration (const int fileIndex, OutputStream& out) const
+{
+    const String variableName (variableNames[fileIndex]);
+
+    out << "    // Compressed with zlib, use getUncompressedNamedResource() to get the uncompressed data." << newLine
+        << (backend == BinaryDataBackend::pack ? "    const char*          " + variableName + "Compressed();"
+                                               : "    extern const char*   " + variableName + "Compressed;") << newLine
+        << "    const int            " << variableName << "CompressedSize = " << (int) compressedFiles.getReference (fileIndex).getSize() << ";" << newLine
+        << "    const int            " << variableName << "Size = " << (int) files.getReference (fileIndex).getSize() << ";" << newLine
+        << newLine;
+}
+
+void ResourceFile::writeCompressionFunctionDeclarations (OutputStream& out) const
+{
+    out << newLine
+        << "    // If you provide the name of one of the binary resource variables above, this function will" << newLine
+        << "    // return the corresponding uncompressed data and its size (or a null pointer if the name isn't" << newLine
+        << "    // found). Compressed resources are decompressed on first access, and stay in memory until the" << newLine
+        << "    // program exits. getNamedResource() returns a null pointer for compressed resources." << newLine
+        << "    const char* getUncompressedNamedResource (const char* resourceNameUTF8, int& dataSizeInBytes);" << newLine
+        << newLine
+        << "    // If you provide the name of one of the binary resource variables above, this function will" << newLine
+        << "    // return the size of its compressed data (or 0 if it isn't compressed or the name isn't found)." << newLine
+        << "    int getNamedResourceCompressedSize (const char* resourceNameUTF8);" << newLine;
+}
+
+void ResourceFile::writeCompressionFunctions (OutputStream& out) const
+{
+    StringArray compressedVariableNames;
+    StringArray uncompressedReturnCodes;
+    StringArray compressedSizeReturnCodes;
+
+    for (int j = 0; j < files.size(); ++j)
+    {
+        const int64 dataSize = files.getReference (j).getSize();
+
+        if (isCompressed (j))
+        {
+            const int64 compressedSize = compressedFiles.getReference (j).getSize();
+
+            uncompressedReturnCodes.add ("return decompressResource (" + String (compressedVariableNames.size()) + ", "
+                                           + getDataExpression (j) + ", " + String (compressedSize) + ", "
+                                           + String (dataSize) + ", numBytes);");
+            compressedSizeReturnCodes.add ("return " + String (compressedSize) + ";");
+            compressedVariableNames.add (variableNames[j]);
+        }
+        else
+        {
+            uncompressedReturnCodes.add (getNamedResourceReturnCode (j));
+        }
+    }
+
+    if (compressedVariableNames.size() > 0)
+    {
+        out << newLine
+            << "static const char* decompressResource (int index, const char* data, int dataSize, int uncompressedSize, int& numBytes)" << newLine
+            << "{" << newLine
+            << "    static std::once_flag decompressedFlags[" << compressedVariableNames.size() << "];" << newLine
+            << "    static std::unique_ptr<char[]> decompressedData[" << compressedVariableNames.size() << "];" << newLine
+            << newLine
+            << "    std::call_once (decompressedFlags[index], [=]" << newLine
+            << "    {" << newLine
+            << "        if (data == nullptr)" << newLine
+            << "            return;" << newLine
+            << newLine
+            << "        std::unique_ptr<char[]> decompressed (new char[(size_t) uncompressedSize + 1]);" << newLine
+            << "        juce::MemoryInputStream compressedStream (data, (size_t) dataSize, false);" << newLine
+            << "        juce::GZIPDecompressorInputStream decompressor (compressedStream);" << newLine
+            << newLine
+            << "        if (decompressor.read (decompressed.get(), uncompressedSize) == uncompressedSize)" << newLine
+            << "        {" << newLine
+            << "            decompressed[(size_t) uncompressedSize] = 0;" << newLine
+            << "            decompressedData[index] = std::move (decompressed);" << newLine
+            << "        }" << newLine
+            << "    });" << newLine
+            << newLine
+            << "    numBytes = decompressedData[index] != nullptr ? uncompressedSize : 0;" << newLine
+            << "    return decompressedData[index].get();" << newLine
+            << "}" << newLine;
+    }
+
+    out << newLine
+        << "const char* getUncompressedNamedResource (const char* resourceNameUTF8, int& numBytes)" << newLine
+        << "{" << newLine;
+
+    writeStringMatcher (out, variableNames, uncompressedReturnCodes);
+
+    out << "    numBytes = 0;" << newLine
+        << "    return nullptr;" << newLine
+        << "}" << newLine
+        << newLine
+        << "int getNamedResourceCompressedSize (const char* resourceNameUTF8)" << newLine
+        << "{" << newLine;
+
+    writeStringMatcher (out, compressedVariableNames, compressedSizeReturnCodes);
+
+    out << "    return 0;" << newLine
+        << "}" << newLine;
+}
+
+String ResourceFile::getDataSymbol (const String& tempVariable) const
+{
+    return "frut_" + className + "_" + String (project.getProjectUID().hashCode() & 0x7ffffff) + "_" + tempVariable;
+}
+
+void ResourceFile::writeIncbinMacros (OutputStream& out) const
+{
+    out << newLine
+        << "// The previous section is restored after each resource, so that the code generated by" << newLine
+        << "// the compiler after a top-level asm statement stays in the section it expects" << newLine
+        << "#if defined (__APPLE__)" << newLine
+        << " #define FRUT_BINARYDATA_SECTION \".const_data\"" << newLine
+        << " #define FRUT_BINARYDATA_PREVIOUS_SECTION \".previous\"" << newLine
+        << " #define FRUT_BINARYDATA_SYMBOL(name) \".globl \" name \"\\n.private_extern \" name \"\\n\" name \":\\n\"" << newLine
+        << "#elif defined (_WIN32)" << newLine
+        << " // Not every COFF assembler supports .pushsection, and top-level asm statements are" << newLine
+        << " // emitted in .text there" << newLine
+        << " #define FRUT_BINARYDATA_SECTION \".section .rdata,\\\"dr\\\"\"" << newLine
+        << " #define FRUT_BINARYDATA_PREVIOUS_SECTION \".text\"" << newLine
+        << " #define FRUT_BINARYDATA_SYMBOL(name) \".globl \" name \"\\n\" name \":\\n\"" << newLine
+        << "#else" << newLine
+        << " #define FRUT_BINARYDATA_SECTION \".pushsection .rodata\"" << newLine
+        << " #define FRUT_BINARYDATA_PREVIOUS_SECTION \".popsection\"" << newLine
+        << " #define FRUT_BINARYDATA_SYMBOL(name) \".globl \" name \"\\n.hidden \" name \"\\n\" name \":\\n\"" << newLine
+        << "#endif" << newLine;
+}
+
+// The resource file is embedded by the assembler, so the compiler doesn't have to parse a
+// huge literal. The content hash makes sure that the file is compiled again when the
+// resource file changes.
+void ResourceFile::writeIncbinData (const File& file, const File& dataFile, const String& tempVariable, OutputStream& out) const
+{
+    const String symbol (getDataSymbol (tempVariable));
+    String path (dataFile.getFullPathName());
+
+    // The assembler reads backslashes as escape characters, and Windows accepts forward
+    // slashes, but a backslash is a valid character of a file name on other platforms
+    if (File::getSeparatorChar() == '\\')
+        path = path.replaceCharacter ('\\', '/');
+
+    path = path.replace ("\\", "\\\\\\\\").replace ("\"", "\\\\\\\"");
+
+    const MappedResourceFile data (dataFile);
+
+    out << newLine << "//================== " << file.getFileName() << " ==================" << newLine
+        << "// Content hash: " << ContentHash::toHexString (ContentHash::compute (data.getData(), data.getSize())) << newLine
+        << "extern \"C\" const unsigned char " << tempVariable << "[] __asm__ (\"" << symbol << "\");" << newLine
+        << newLine
+        << "__asm__ (FRUT_BINARYDATA_SECTION \"\\n\"" << newLine;
+
+    if (alignment > 1)
+        out << "         \".balign " << alignment << "\\n\"" << newLine;
+
+    out << "         FRUT_BINARYDATA_SYMBOL (\"" << symbol << "\")" << newLine
+        << "         \".incbin \\\"" << path << "\\\"\\n\"" << newLine
+        << "         \".byte 0\\n\"" << newLine;
+
+    if (alignment > 1)
+        out << "         \".balign " << alignment << ", 0\\n\"" << newLine;
+
+    out << "         FRUT_BINARYDATA_PREVIOUS_SECTION);" << newLine;
 }
 
-//==============================================================================
-void ResourceFile::setClassName (const String& name)
+// The resource file is written in the ELF object file by ElfObjectWriter
+void ResourceFile::writeElfObjectDataDeclaration (const File& file, const String& tempVariable, OutputStream& out) const
 {
-    className = name;
+    out << newLine << "//================== " << file.getFileName() << " ==================" << newLine
+        << "extern \"C\" const unsigned char " << tempVariable << "[] __asm__ (\"" << getDataSymbol (tempVariable) << "\");" << newLine;
 }
 
-void ResourceFile::addFile (const File& file)
+Result ResourceFile::writeElfObject (Array<File>& filesCreated)
 {
-    files.add (file);
+    const File objectFile (project.getBinaryDataObjectFile());
 
-    const String variableNameRoot (CodeHelpers::makeBinaryDataIdentifierName (file));
-    String variableName (variableNameRoot);
+    Array<File> dataFiles;
+    StringArray symbols;
+    for (int i = 0; i < files.size(); ++i)
+    {
+        if (isDuplicate (i))
+            continue;
 
-    int suffix = 2;
-    while (variableNames.contains (variableName))
-        variableName = variableNameRoot + String (suffix++);
+        dataFiles.add (getDataFile (i));
+        symbols.add (getDataSymbol (getTempVariableName (i)));
+    }
 
-    variableNames.add (variableName);
+    Result r (ElfObjectWriter::write (objectFile, elfMachine, dataFiles, symbols, alignment));
+
+    if (r.failed())
+        return r;
+
+    filesCreated.add (objectFile);
+    return Result::ok();
 }
 
-static String getComment()
+// The pack file is written next to the BinaryData files, and must be copied next to the
+// executable or plugin binary, or to the Resources folder of macOS bundles (Reprojucer does
+// it when building each target)
+void ResourceFile::writePackLoader (OutputStream& out) const
 {
-    String comment;
-    comment << newLine << newLine
-            << "   This is an auto-generated file: Any edits you make may be overwritten!" << newLine
-            << newLine
-            << "*/" << newLine
-            << newLine;
+    const String packFileName (project.getBinaryDataPackFile().getFileName());
+
+    int numEntries = 0;
+    for (auto entryIndex : packEntryIndices)
+        if (entryIndex >= 0)
+            ++numEntries;
+
+    out << newLine
+        << "// Returns a pointer to the content of the entry at entryIndex in " << packFileName << "," << newLine
+        << "// which is memory-mapped on first access and stays mapped until the program exits." << newLine
+        << "// Returns a null pointer and sets numBytes to 0 if the pack file is missing or doesn't" << newLine
+        << "// match this file." << newLine
+        << "static const char* getPackedResource (int entryIndex, int& numBytes)" << newLine
+        << "{" << newLine
+        << "    struct Pack" << newLine
+        << "    {" << newLine
+        << "        Pack()" << newLine
+        << "        {" << newLine
+        << "            const juce::File executableFile (juce::File::getSpecialLocation (juce::File::currentExecutableFile));" << newLine
+        << "            juce::File packFile (executableFile.getSiblingFile (" << packFileName.quoted() << "));" << newLine
+        << newLine
+        << "           #if JUCE_MAC" << newLine
+        << "            // The binary of a bundle is in Contents/MacOS, and its resources in Contents/Resources" << newLine
+        << "            if (executableFile.getParentDirectory().getFileName() == \"MacOS\")" << newLine
+        << "                packFile = executableFile.getParentDirectory().getSiblingFile (\"Resources\")" << newLine
+        << "                                         .getChildFile (" << packFileName.quoted() << ");" << newLine
+        << "           #endif" << newLine
+        << newLine
+        << "            mappedFile.reset (new juce::MemoryMappedFile (packFile, juce::MemoryMappedFile::readOnly));" << newLine
+        << newLine
+        << "            const char* bytes = static_cast<const char*> (mappedFile->getData());" << newLine
+        << "            const size_t size = mappedFile->getSize();" << newLine
+        << newLine
+        << "            if (bytes != nullptr && size >= " << PackFileWriter::headerSize << " + " << PackFileWriter::entrySize << " * (size_t) " << numEntries << newLine
+        << "                 && memcmp (bytes, \"FRUTPACK\", 8) == 0" << newLine
+        << "                 && juce::ByteOrder::littleEndianInt (bytes + 8) == " << PackFileWriter::version << newLine
+        << "                 && juce::ByteOrder::littleEndianInt (bytes + 12) == " << numEntries << newLine
+        << "                 && juce::ByteOrder::littleEndianInt64 (bytes + 16) == 0x" << ContentHash::toHexString (packId) << "ull)" << newLine
+        << "            {" << newLine
+        << "                data = bytes;" << newLine
+        << "                dataSize = size;" << newLine
+        << "            }" << newLine
+        << "        }" << newLine
+        << newLine
+        << "        std::unique_ptr<juce::MemoryMappedFile> mappedFile;" << newLine
+        << "        const char* data = nullptr;" << newLine
+        << "        size_t dataSize = 0;" << newLine
+        << "    };" << newLine
+        << newLine
+        << "    static const Pack pack;" << newLine
+        << newLine
+        << "    numBytes = 0;" << newLine
+        << newLine
+        << "    if (pack.data == nullptr)" << newLine
+        << "        return nullptr;" << newLine
+        << newLine
+        << "    const char* entry = pack.data + " << PackFileWriter::headerSize << " + " << PackFileWriter::entrySize << " * (size_t) entryIndex;" << newLine
+        << "    const juce::uint64 offset = juce::ByteOrder::littleEndianInt64 (entry);" << newLine
+        << "    const juce::uint64 size = juce::ByteOrder::littleEndianInt64 (entry + 8);" << newLine
+        << newLine
+        << "    // The content of each entry is followed by a null byte" << newLine
+        << "    if (offset >= pack.dataSize || size >= pack.dataSize - offset)" << newLine
+        << "        return nullptr;" << newLine
+        << newLine
+        << "    numBytes = (int) size;" << newLine
+        << "    return pack.data + offset;" << newLine
+        << "}" << newLine;
+}
 
-    return comment;
+// The pack file is only memory-mapped when one of the resources is accessed, so the
+// resources are functions instead of variables, which would be initialized when the
+// program (or plugin) is loaded, in an unspecified order
+void ResourceFile::writePackResourceDeclaration (const int fileIndex, OutputStream& out) const
+{
+    const String variableName (variableNames[fileIndex]);
+
+    out << "    // Returns a null pointer if " << project.getBinaryDataPackFile().getFileName() << " is missing." << newLine
+        << "    const char*          " << variableName << "();" << newLine
+        << "    const int            " << variableName << "Size = " << (int) files.getReference (fileIndex).getSize() << ";" << newLine
+        << newLine;
 }
 
-template <ProjucerVersion>
-Result ResourceFile::writeHeader (MemoryOutputStream& header)
+void ResourceFile::writePackDataDeclaration (const File& file, const int fileIndex, OutputStream& out) const
 {
-    const String headerGuard ("BINARYDATA_H_" + String (project.getProjectUID().hashCode() & 0x7ffffff) + "_INCLUDED");
+    out << newLine << "//================== " << file.getFileName() << " ==================" << newLine;
 
-    header << "/* ========================================================================================="
-           << getComment()
-           << "#ifndef " << headerGuard << newLine
-           << "#define " << headerGuard << newLine
-           << newLine
-           << "namespace " << className << newLine
-           << "{" << newLine;
+    Array<int> fileIndices;
+    fileIndices.add (fileIndex);
 
-    // bool containsAnyImages = false;
+    auto duplicates = duplicateFileIndices.find (fileIndex);
 
-    for (int i = 0; i < files.size(); ++i)
-    {
-        const File& file = files.getReference(i);
+    if (duplicates != duplicateFileIndices.end())
+        fileIndices.addArray (duplicates->second);
 
-        if (! file.existsAsFile())
-            return Result::fail ("Can't open resource file: " + file.getFullPathName());
+    for (auto index : fileIndices)
+        out << "const char* " << getDataVariableName (index) << "()" << newLine
+            << "{" << newLine
+            << "    int numBytes = 0;" << newLine
+            << "    return getPackedResource (" << packEntryIndices[fileIndex] << ", numBytes);" << newLine
+            << "}" << newLine;
+}
 
-        const int64 dataSize = file.getSize();
+// Pointer to the data of the resource file at fileIndex (which can be compressed) in the
+// generated code
+String ResourceFile::getDataExpression (const int fileIndex) const
+{
+    return getDataVariableName (fileIndex) + (backend == BinaryDataBackend::pack ? "()" : "");
+}
 
-        const String variableName (variableNames[i]);
+// Code returning the uncompressed data of the resource file at fileIndex, and setting
+// numBytes to its size, in the lookup functions of the generated code
+String ResourceFile::getNamedResourceReturnCode (const int fileIndex) const
+{
+    if (backend == BinaryDataBackend::pack)
+        return "return getPackedResource (" + String (packEntryIndices[originalFileIndices[fileIndex]]) + ", numBytes);";
 
-        FileInputStream fileStream (file);
+    return "numBytes = " + String (files.getReference (fileIndex).getSize()) + "; return " + variableNames[fileIndex] + ";";
+}
 
-        if (fileStream.openedOk())
-        {
-            // containsAnyImages = containsAnyImages
-            //                      || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
+Result ResourceFile::writePackFile()
+{
+    const File packFile (project.getBinaryDataPackFile());
 
-            header << "    extern const char*   " << variableName << ";" << newLine;
-            header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
+    Array<File> dataFiles;
+    packEntryIndices.clearQuick();
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        if (isDuplicate (i))
+        {
+            packEntryIndices.add (-1);
+            continue;
         }
-    }
 
-    header << "    // Points to the start of a list of resource names." << newLine
-           << "    extern const char* namedResourceList[];" << newLine
-           << newLine
-           << "    // Number of elements in the namedResourceList array." << newLine
-           << "    const int namedResourceListSize = " << files.size() <<  ";" << newLine
-           << newLine
-           << "    // If you provide the name of one of the binary resource variables above, this function will" << newLine
-           << "    // return the corresponding data and its size (or a null pointer if the name isn't found)." << newLine
-           << "    const char* getNamedResource (const char* resourceNameUTF8, int& dataSizeInBytes) throw();" << newLine
-           << "}" << newLine
-           << newLine
-           << "#endif" << newLine;
+        packEntryIndices.add (dataFiles.size());
+        dataFiles.add (getDataFile (i));
+    }
 
-    return Result::ok();
+    return PackFileWriter::write (packFile, dataFiles, alignment, packId);
 }
 
-template <ProjucerVersion>
-Result ResourceFile::writeCpp (MemoryOutputStream& cpp, const File& headerFile, int& i, const int maxFileSize)
+// The ParallelLiteralEncoder keeps the literals that it encodes ahead in memory, so the
+// biggest resource files are encoded directly to the BinaryData.cpp file instead
+bool ResourceFile::isEncodedInParallel (const int fileIndex) const
 {
-    const bool isFirstFile = (i == 0);
+    const int64 maxSizeForParallelEncoding = 8 * 1024 * 1024;
 
-    cpp << "/* ==================================== " << resourceFileIdentifierString << " ===================================="
-        << getComment()
-        << "namespace " << className << newLine
-        << "{" << newLine;
+    return encoder != nullptr && getDataFile (fileIndex).getSize() <= maxSizeForParallelEncoding;
+}
 
-    // bool containsAnyImages = false;
+void ResourceFile::writeDataAsCppLiteral (const int writeIndex, OutputStream& out)
+{
+    const int fileIndex = getFileIndex (writeIndex);
+
+    // The ParallelLiteralEncoder encodes the literals in the order they are written
+    if (isEncodedInParallel (fileIndex))
+        encoder->writeLiteral (writeIndex, out);
+    else
+        encodeDataAsCppLiteral (getDataFile (fileIndex), out);
+}
 
-    while (i < files.size())
+// Also called from the threads of the ParallelLiteralEncoder
+void ResourceFile::encodeDataAsCppLiteral (const File& file, OutputStream& out)
+{
+    if (cache != nullptr)
     {
-        const File& file = files.getReference(i);
-        const String variableName (variableNames[i]);
+        cache->writeDataAsCppLiteral (file, out);
+        return;
+    }
 
-        FileInputStream fileStream (file);
+    const MappedResourceFile data (file);
 
-        if (fileStream.openedOk())
-        {
-            // containsAnyImages = containsAnyImages
-            //                      || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
+    if (data.openedOk())
+        CodeHelpers::writeDataAsCppLiteral (data.getData(), data.getSize(), out, true, true);
+}
 
-            const String tempVariable ("temp_binary_data_" + String (i));
+// Like FileHelpers::overwriteFileWithNewDataIfDifferent(), but the new content is written
+// to a temporary file, so that a BinaryData.cpp file doesn't have to fit in memory
+static bool overwriteFileWithTemporaryIfDifferent (const TemporaryFile& temporaryFile)
+{
+    const File& file = temporaryFile.getTargetFile();
 
-            cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
-                << "static const unsigned char " << tempVariable << "[] =" << newLine;
+    if (file.getSize() == temporaryFile.getFile().getSize()
+          && file.hasIdenticalContentTo (temporaryFile.getFile()))
+        return true;
 
-            {
-                MemoryBlock data;
-                fileStream.readIntoMemoryBlock (data);
-                CodeHelpers::writeDataAsCppLiteral (data, cpp, true, true);
-            }
+    return temporaryFile.overwriteTargetFileWithTemporary();
+}
 
-            cpp << newLine << newLine
-                << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
-        }
+template <ProjucerVersion jucerVersion>
+Result ResourceFile::write (Array<File>& filesCreated, const int maxFileSize)
+{
+    const File headerFile (project.getBinaryDataHeaderFile());
 
-        ++i;
+    if (compressResources)
+    {
+        Result r (compressFiles());
 
-        if (cpp.getPosition() > maxFileSize)
-            break;
+        if (r.failed())
+            return r;
     }
 
-    if (isFirstFile)
     {
-        if (i < files.size())
-        {
-            cpp << newLine
-                << "}" << newLine
-                << newLine
-                << "#include \"" << headerFile.getFileName() << "\"" << newLine
-                << newLine
-                << "namespace " << className << newLine
-                << "{";
-        }
+        Result r (findDuplicateFiles());
 
-        cpp << newLine
-            << newLine
-            << "const char* getNamedResource (const char*, int&) throw();" << newLine
-            << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes) throw()" << newLine
-            << "{" << newLine;
+        if (r.failed())
+            return r;
+    }
 
-        StringArray returnCodes;
-        for (int j = 0; j < files.size(); ++j)
-        {
-            const File& file = files.getReference(j);
-            const int64 dataSize = file.getSize();
-            returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[j] + ";");
-        }
+    if (emitContentHashes || useConstexprIndex)
+    {
+        Result r (computeContentHashes());
 
-        CodeHelpers::createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
+        if (r.failed())
+            return r;
+    }
 
-        cpp << "    numBytes = 0;" << newLine
-            << "    return 0;" << newLine
-            << "}" << newLine
-            << newLine
-            << "const char* namedResourceList[] =" << newLine
-            << "{" << newLine;
+    // The resource files are written shard by shard, in the order they were added
+    fileOrder.clearQuick();
+
+    if (numShards > 0)
+    {
+        Array<int> shardIndices;
 
         for (int j = 0; j < files.size(); ++j)
-            cpp << "    " << variableNames[j].quoted() << (j < files.size() - 1 ? "," : "") << newLine;
+        {
+            fileOrder.add (j);
+            shardIndices.add (getShardIndex (j));
+        }
 
-        cpp << "};" << newLine;
+        std::stable_sort (fileOrder.begin(), fileOrder.end(), [&shardIndices] (int a, int b)
+        {
+            return shardIndices[a] < shardIndices[b];
+        });
     }
 
-    cpp << newLine
-        << "}" << newLine;
-
-    return Result::ok();
-}
-
-template <ProjucerVersion jucerVersion>
-Result ResourceFile::write (Array<File>& filesCreated, const int maxFileSize)
-{
-    const File headerFile (project.getBinaryDataHeaderFile());
+    // With the incbin, ELF and pack backends, and with shards, the number of resource files in
+    // each BinaryData.cpp file doesn't depend on their size
+    if (shardPlan.isEmpty() && (backend != BinaryDataBackend::cppLiterals || numShards > 0))
+        shardPlan = computeShardPlan (maxFileSize);
 
     {
         MemoryOutputStream mo;
@@ -261,6 +1404,25 @@ Result ResourceFile::write (Array<File>& filesCreated, const int maxFileSize)
         filesCreated.add (headerFile);
     }
 
+    // The generated code checks that it reads the pack file it was generated with
+    if (backend == BinaryDataBackend::pack)
+    {
+        Result r (writePackFile());
+
+        if (r.failed())
+            return r;
+    }
+
+    if (backend == BinaryDataBackend::cppLiterals && numThreads > 1 && files.size() > 1)
+        encoder.reset (new ParallelLiteralEncoder (files.size(), numThreads,
+                                                   [this] (int writeIndex, OutputStream& out)
+                                                   {
+                                                       const int index = getFileIndex (writeIndex);
+
+                                                       if (isEncodedInParallel (index) && ! isDuplicate (index))
+                                                           encodeDataAsCppLiteral (getDataFile (index), out);
+                                                   }));
+
     int i = 0;
     int fileIndex = 0;
 
@@ -268,23 +1430,57 @@ Result ResourceFile::write (Array<File>& filesCreated, const int maxFileSize)
     {
         File cpp (project.getBinaryDataCppFile (fileIndex));
 
-        MemoryOutputStream mo;
+        if (! cpp.getParentDirectory().createDirectory())
+            return Result::fail ("Can't create directory: " + cpp.getParentDirectory().getFullPathName());
 
-        Result r (writeCpp<jucerVersion> (mo, headerFile, i, maxFileSize));
+        TemporaryFile temporaryCpp (cpp);
+        currentCppFileIndex = fileIndex;
+        firstWriteIndexInCppFile = i;
 
-        if (r.failed())
-            return r;
+        {
+            FileOutputStream out (temporaryCpp.getFile());
+
+            if (! out.openedOk())
+                return Result::fail ("Can't write to file: " + cpp.getFullPathName());
+
+            Result r (writeCpp<jucerVersion> (out, headerFile, i, maxFileSize));
+
+            if (r.failed())
+                return r;
 
-        if (! FileHelpers::overwriteFileWithNewDataIfDifferent (cpp, mo))
+            out.flush();
+
+            if (out.getStatus().failed())
+                return Result::fail ("Can't write to file: " + cpp.getFullPathName());
+        }
+
+        if (! overwriteFileWithTemporaryIfDifferent (temporaryCpp))
             return Result::fail ("Can't write to file: " + cpp.getFullPathName());
 
         filesCreated.add (cpp);
         ++fileIndex;
 
-        if (i >= files.size())
+        if (i >= files.size() && fileIndex >= shardPlan.size())
             break;
     }
 
+    encoder.reset();
+
+    if (backend == BinaryDataBackend::elfObject)
+    {
+        Result r (writeElfObject (filesCreated));
+
+        if (r.failed())
+            return r;
+    }
+
+    if (backend == BinaryDataBackend::pack)
+        filesCreated.add (project.getBinaryDataPackFile());
+
+    // The cache is only an optimization, failing to save it doesn't affect the files created
+    if (cache != nullptr)
+        cache->save();
+
     return Result::ok();
 }
 
@@ -321,8 +1517,16 @@ Result ResourceFile::writeHeader<ProjucerVersion::v5_0_0> (MemoryOutputStream& h
     header << "/* ========================================================================================="
            << getComment()
            << "#pragma once" << newLine
-           << newLine
-           << "namespace " << className << newLine
+           << newLine;
+
+    if (useConstexprIndex)
+        writeConstexprIndexIncludes (header);
+
+    if (hasDecodedImages)
+        header << "namespace juce { class Image; }" << newLine
+               << newLine;
+
+    header << "namespace " << className << newLine
            << "{" << newLine;
 
     // bool containsAnyImages = false;
@@ -338,6 +1542,18 @@ Result ResourceFile::writeHeader<ProjucerVersion::v5_0_0> (MemoryOutputStream& h
 
         const String variableName (variableNames[i]);
 
+        if (isCompressed (i))
+        {
+            writeCompressedResourceDeclaration (i, header);
+            continue;
+        }
+
+        if (backend == BinaryDataBackend::pack)
+        {
+            writePackResourceDeclaration (i, header);
+            continue;
+        }
+
         FileInputStream fileStream (file);
 
         if (fileStream.openedOk())
@@ -358,8 +1574,24 @@ Result ResourceFile::writeHeader<ProjucerVersion::v5_0_0> (MemoryOutputStream& h
            << newLine
            << "    // If you provide the name of one of the binary resource variables above, this function will" << newLine
            << "    // return the corresponding data and its size (or a null pointer if the name isn't found)." << newLine
-           << "    const char* getNamedResource (const char* resourceNameUTF8, int& dataSizeInBytes) throw();" << newLine
-           << "}" << newLine;
+           << "    const char* getNamedResource (const char* resourceNameUTF8, int& dataSizeInBytes) throw();" << newLine;
+
+    if (compressResources)
+        writeCompressionFunctionDeclarations (header);
+
+    if (alignment > 1)
+        writeAlignmentDeclarations (header);
+
+    if (useConstexprIndex && ! files.isEmpty())
+        writeConstexprIndex (header);
+
+    if (emitContentHashes)
+        writeContentHashDeclarations (header);
+
+    if (hasDecodedImages)
+        writeDecodedImageFunctionDeclaration (header);
+
+    header << "}" << newLine;
 
     return Result::ok();
 }
@@ -397,8 +1629,16 @@ Result ResourceFile::writeHeader<ProjucerVersion::v5_3_1> (MemoryOutputStream& h
     header << "/* ========================================================================================="
            << getComment()
            << "#pragma once" << newLine
-           << newLine
-           << "namespace " << className << newLine
+           << newLine;
+
+    if (useConstexprIndex)
+        writeConstexprIndexIncludes (header);
+
+    if (hasDecodedImages)
+        header << "namespace juce { class Image; }" << newLine
+               << newLine;
+
+    header << "namespace " << className << newLine
            << "{" << newLine;
 
     // bool containsAnyImages = false;
@@ -414,6 +1654,18 @@ Result ResourceFile::writeHeader<ProjucerVersion::v5_3_1> (MemoryOutputStream& h
 
         auto variableName = variableNames[i];
 
+        if (isCompressed (i))
+        {
+            writeCompressedResourceDeclaration (i, header);
+            continue;
+        }
+
+        if (backend == BinaryDataBackend::pack)
+        {
+            writePackResourceDeclaration (i, header);
+            continue;
+        }
+
         FileInputStream fileStream (file);
 
         if (fileStream.openedOk())
@@ -441,55 +1693,102 @@ Result ResourceFile::writeHeader<ProjucerVersion::v5_3_1> (MemoryOutputStream& h
            << newLine
            << "    // If you provide the name of one of the binary resource variables above, this function will"             << newLine
            << "    // return the corresponding original, non-mangled filename (or a null pointer if the name isn't found)."  << newLine
-           << "    const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);"                             << newLine
-           << "}" << newLine;
+           << "    const char* getNamedResourceOriginalFilename (const char* resourceNameUTF8);"                             << newLine;
+
+    if (compressResources)
+        writeCompressionFunctionDeclarations (header);
+
+    if (alignment > 1)
+        writeAlignmentDeclarations (header);
+
+    if (useConstexprIndex && ! files.isEmpty())
+        writeConstexprIndex (header);
+
+    if (emitContentHashes)
+        writeContentHashDeclarations (header);
+
+    if (hasDecodedImages)
+        writeDecodedImageFunctionDeclaration (header);
+
+    header << "}" << newLine;
 
     return Result::ok();
 }
 
 template <>
-Result ResourceFile::writeCpp<ProjucerVersion::v5_3_1> (MemoryOutputStream& cpp, const File& headerFile, int& i, const int maxFileSize)
+Result ResourceFile::writeCpp<ProjucerVersion::v5_3_1> (OutputStream& cpp, const File& headerFile, int& i, const int maxFileSize)
 {
-    bool isFirstFile = (i == 0);
+    bool isFirstFile = (currentCppFileIndex == 0);
 
     cpp << "/* ==================================== " << resourceFileIdentifierString << " ===================================="
-        << getComment()
-        << "namespace " << className << newLine
+        << getComment();
+
+    // The compressed resources are decompressed, and the pack file is memory-mapped, with
+    // juce_core, and the decoded images are copied to juce::Image objects
+    if (isFirstFile && (compressResources || backend == BinaryDataBackend::pack || hasDecodedImages))
+        cpp << "#include \"JuceHeader.h\"" << newLine
+            << newLine
+            << "#include <memory>" << newLine
+            << "#include <mutex>" << newLine
+            << newLine;
+
+    cpp << "namespace " << className << newLine
         << "{" << newLine;
 
+    if (backend == BinaryDataBackend::incbin)
+        writeIncbinMacros (cpp);
+
+    if (backend == BinaryDataBackend::pack && ! files.isEmpty())
+        writePackLoader (cpp);
+
     // bool containsAnyImages = false;
 
-    while (i < files.size())
+    while (i < files.size() && ! isCppFileFull (cpp, i, maxFileSize))
     {
-        auto& file = files.getReference(i);
-        auto variableName = variableNames[i];
+        auto fileIndex = getFileIndex (i);
+        auto& file = files.getReference(fileIndex);
+        auto variableName = getDataVariableName (fileIndex);
 
-        FileInputStream fileStream (file);
+        FileInputStream fileStream (getDataFile (fileIndex));
 
-        if (fileStream.openedOk())
+        if (fileStream.openedOk() && ! isDuplicate (fileIndex))
         {
             // containsAnyImages = containsAnyImages
             //                      || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
 
-            auto tempVariable = "temp_binary_data_" + String (i);
-
-            cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
-                 << "static const unsigned char " << tempVariable << "[] =" << newLine;
+            auto tempVariable = getTempVariableName (fileIndex);
 
+            if (backend == BinaryDataBackend::incbin)
+            {
+                writeIncbinData (file, getDataFile (fileIndex), tempVariable, cpp);
+            }
+            else if (backend == BinaryDataBackend::elfObject)
+            {
+                writeElfObjectDataDeclaration (file, tempVariable, cpp);
+            }
+            else if (backend == BinaryDataBackend::pack)
+            {
+                writePackDataDeclaration (file, fileIndex, cpp);
+            }
+            else
             {
-                MemoryBlock data;
-                fileStream.readIntoMemoryBlock (data);
-                CodeHelpers::writeDataAsCppLiteral (data, cpp, true, true);
+                cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
+                     << getAlignmentSpecifier() << "static const unsigned char " << tempVariable << "[" << getPaddedArraySize (fileIndex) << "] =" << newLine;
+
+                writeDataAsCppLiteral (i, cpp);
             }
 
-            cpp << newLine << newLine
-                << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
+            // The resources of the pack file are functions, written by writePackDataDeclaration()
+            if (backend != BinaryDataBackend::pack)
+            {
+                cpp << newLine << newLine
+                    << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
+
+                writeDuplicateDefinitions (fileIndex, tempVariable, cpp);
+            }
         }
 
         ++i;
-
-        if (cpp.getPosition() > maxFileSize)
-            break;
     }
 
     if (isFirstFile)
@@ -510,14 +1809,21 @@ Result ResourceFile::writeCpp<ProjucerVersion::v5_3_1> (MemoryOutputStream& cpp,
             << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)" << newLine
             << "{" << newLine;
 
+        auto firstFileIndices = getFirstFileIndices();
+
         StringArray returnCodes;
-        for (auto& file : files)
+        for (int j = 0; j < files.size(); ++j)
         {
-            auto dataSize = file.getSize();
-            returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[files.indexOf (file)] + ";");
+            if (isCompressed (firstFileIndices[j]))
+            {
+                returnCodes.add ("numBytes = 0; return nullptr;");
+                continue;
+            }
+
+            returnCodes.add (getNamedResourceReturnCode (firstFileIndices[j]));
         }
 
-        CodeHelpers::createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
+        writeStringMatcher (cpp, variableNames, returnCodes);
 
         cpp << "    numBytes = 0;" << newLine
             << "    return nullptr;" << newLine
@@ -535,8 +1841,8 @@ Result ResourceFile::writeCpp<ProjucerVersion::v5_3_1> (MemoryOutputStream& cpp,
         cpp << "const char* originalFilenames[] =" << newLine
             << "{" << newLine;
 
-        for (auto& f : files)
-            cpp << "    " << f.getFileName().quoted() << (files.indexOf (f) < files.size() - 1 ? "," : "") << newLine;
+        for (int j = 0; j < files.size(); ++j)
+            cpp << "    " << files.getReference (j).getFileName().quoted() << (firstFileIndices[j] < files.size() - 1 ? "," : "") << newLine;
 
         cpp << "};" << newLine << newLine;
 
@@ -551,6 +1857,15 @@ Result ResourceFile::writeCpp<ProjucerVersion::v5_3_1> (MemoryOutputStream& cpp,
             << "    return nullptr;"                                                                                 << newLine
             << "}"                                                                                                   << newLine
             <<                                                                                                          newLine;
+
+        if (compressResources)
+            writeCompressionFunctions (cpp);
+
+        if (hasDecodedImages)
+            writeDecodedImageFunction (cpp);
+
+        if (emitContentHashes)
+            writeContentHashFunction (cpp);
     }
 
     cpp << "}" << newLine;
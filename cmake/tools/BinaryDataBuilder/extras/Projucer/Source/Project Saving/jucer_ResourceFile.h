@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2019  Alain Martin
+// Copyright (C) 2017-2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,7 +17,7 @@
 
 // clang-format off
 
-// Lines 24-51, 62-72, 75-82, 85, and 87-91 of this file were copied from
+// Lines 24-51, 76-86, 89, 170-173, 175-176, 245, and 248-251 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/4.2.0/extras/Projucer/Source/Project%20Saving/jucer_ResourceFile.h
 
 
@@ -49,6 +49,11 @@
 #define JUCER_RESOURCEFILE_H_INCLUDED
 
 #include "../Project/jucer_Project.h"
+#include "jucer_ParallelLiteralEncoder.h"
+#include "jucer_ResourceFileCache.h"
+
+#include <map>
+#include <set>
 
 
 enum class ProjucerVersion
@@ -59,6 +64,15 @@ enum class ProjucerVersion
 };
 
 
+enum class BinaryDataBackend
+{
+  cppLiterals,
+  incbin,
+  elfObject,
+  pack,
+};
+
+
 //==============================================================================
 class ResourceFile
 {
@@ -74,17 +88,163 @@ public:
     template <ProjucerVersion>
     Result write (Array<File>& filesCreated, int maxFileSize);
 
+    //==============================================================================
+    // Number of resource files to write in each BinaryData.cpp file, computed from the
+    // sizes of the resource files only, so that it's cheap to compute
+    Array<int> computeShardPlan (int maxFileSize) const;
+
+    Result setShardPlan (const Array<int>& numFilesPerCppFile);
+
+    // Instead of filling the BinaryData.cpp files one after the other, the resource files are
+    // spread over numShards BinaryData.cpp files based on a hash of their file names, so that
+    // adding, removing or modifying a resource file only changes one of them. The lookup
+    // functions are written in a BinaryData.cpp file of their own.
+    //
+    // The shards don't depend on the sizes of the resource files, so they can be unbalanced,
+    // and the duplicates of a resource file (see setDeduplicateResources()) are defined in
+    // the shard of the resource file they share their data with.
+    void setNumberOfShards (int numShards);
+
+    // Reuses the C++ literals of the resource files that didn't change since the last time
+    // they were written with the same cache directory
+    void setCacheDirectory (const File& cacheDirectory);
+
+    // The literals of the resource files are encoded on numThreads threads, while still
+    // being written in the same order
+    void setNumberOfThreads (int numThreads);
+
+    // With BinaryDataBackend::incbin, each resource file is written in its own BinaryData.cpp
+    // file, and is embedded with the .incbin directive of the assembler (not supported by
+    // MSVC)
+    //
+    // With BinaryDataBackend::pack, the resource files are written in a BinaryData.pack file
+    // (see PackFileWriter) instead of being embedded, and the generated code memory-maps it
+    // from the directory of the executable or plugin binary (or from the Resources folder of
+    // macOS bundles) on first access. The resources are then functions returning a null
+    // pointer if the pack file is missing, and getNamedResource() returns 0 bytes.
+    void setBackend (BinaryDataBackend);
+
+    // With BinaryDataBackend::elfObject, the resource files are written in a BinaryData.o
+    // ELF object file for the given machine (see ElfObjectWriter::isSupportedMachine())
+    void setElfMachine (const String& machine);
+
+    // Aligns the data of each resource file to the given number of bytes (a power of 2, at
+    // most maxAlignment), and pads it with null bytes to a multiple of it, with all backends.
+    // The generated code requires C++11 when the alignment is greater than 1.
+    void setAlignment (int alignment);
+
+    static const int maxAlignment = 4096;
+
+    // Writes a constexpr table of the resource files in the BinaryData.h file, with a
+    // constexpr lookup by name, so that names can be resolved when compiling. The generated
+    // code requires C++17, and the BinaryData.h file changes whenever a resource file does.
+    void setUseConstexprIndex (bool shouldUseConstexprIndex);
+
+    // Writes the xxHash64 of each resource file, and an aggregate hash of all of them and
+    // their names, as constants in the BinaryData.h file, with a getNamedResourceContentHash()
+    // function. The BinaryData.h file changes whenever a resource file does.
+    void setEmitContentHashes (bool shouldEmitContentHashes);
+
+    // Some of the resource files are images decoded by ImageDecoder, so the generated code
+    // contains a getDecodedImage() function, which requires juce_graphics
+    void setHasDecodedImages (bool hasDecodedImages);
+
+    // Compresses the resource files with zlib, and only embeds the compressed data when it's
+    // significantly smaller. The generated code decompresses it on first access, in
+    // getUncompressedNamedResource().
+    void setCompressResources (bool shouldCompressResources);
+
+    // Resource files with the same content as a previous resource file are only embedded
+    // once, their variables point to the same data
+    void setDeduplicateResources (bool shouldDeduplicateResources);
+
+    // Number of bytes that weren't embedded again thanks to setDeduplicateResources(), only
+    // valid after write()
+    int64 getNumDeduplicatedBytes() const;
+
+    // getNamedResource() and the other lookup functions of the generated code use a minimal
+    // perfect hash table instead of a switch statement, which scales better with thousands of
+    // resource files
+    void setUsePerfectHashLookup (bool shouldUsePerfectHashLookup);
+
     //==============================================================================
 private:
     Array<File> files;
     StringArray variableNames;
+    std::set<String> usedVariableNames;
     Project& project;
     String className;
+    Array<int> shardPlan;
+    int numShards = 0;
+    Array<int> fileOrder;
+    int currentCppFileIndex = 0;
+    int firstWriteIndexInCppFile = 0;
+    std::unique_ptr<ResourceFileCache> cache;
+    int numThreads = 1;
+    std::unique_ptr<ParallelLiteralEncoder> encoder;
+    BinaryDataBackend backend = BinaryDataBackend::cppLiterals;
+    String elfMachine;
+    int alignment = 1;
+    bool useConstexprIndex = false;
+    bool emitContentHashes = false;
+    Array<uint64> contentHashes;
+    bool hasDecodedImages = false;
+    bool compressResources = false;
+    Array<File> compressedFiles;
+    bool usePerfectHashLookup = false;
+    bool deduplicateResources = false;
+    Array<int> originalFileIndices;
+    std::map<int, Array<int>> duplicateFileIndices;
+    int64 numDeduplicatedBytes = 0;
+    Array<int> packEntryIndices;
+    uint64 packId = 0;
+
+    bool isCppFileFull (OutputStream&, int numFilesWritten, int maxFileSize) const;
+    int getShardIndex (int fileIndex) const;
+    int getFileIndex (int writeIndex) const;
+    String getTempVariableName (int fileIndex) const;
+    Result compressFiles();
+    Result findDuplicateFiles();
+    bool isDuplicate (int fileIndex) const;
+    void writeDuplicateDefinitions (int fileIndex, const String& tempVariable, OutputStream&) const;
+    bool isCompressed (int fileIndex) const;
+    File getDataFile (int fileIndex) const;
+    String getDataVariableName (int fileIndex) const;
+    void writeStringMatcher (OutputStream&, const StringArray& strings, const StringArray& codeToExecute) const;
+    Array<int> getFirstFileIndices() const;
+    void writeCompressedResourceDeclaration (int fileIndex, OutputStream&) const;
+    void writeCompressionFunctionDeclarations (OutputStream&) const;
+    void writeCompressionFunctions (OutputStream&) const;
+    bool isEncodedInParallel (int fileIndex) const;
+    void writeDataAsCppLiteral (int writeIndex, OutputStream&);
+    void encodeDataAsCppLiteral (const File&, OutputStream&);
+    String getDataSymbol (const String& tempVariable) const;
+    void writeIncbinMacros (OutputStream&) const;
+    void writeIncbinData (const File&, const File& dataFile, const String& tempVariable, OutputStream&) const;
+    void writeElfObjectDataDeclaration (const File&, const String& tempVariable, OutputStream&) const;
+    Result writeElfObject (Array<File>& filesCreated);
+    String getAlignmentSpecifier() const;
+    String getPaddedArraySize (int fileIndex) const;
+    void writeAlignmentDeclarations (OutputStream&) const;
+    void writeConstexprIndexIncludes (OutputStream&) const;
+    void writeConstexprIndex (OutputStream&) const;
+    Result computeContentHashes();
+    uint64 getAggregateContentHash() const;
+    void writeContentHashDeclarations (OutputStream&) const;
+    void writeContentHashFunction (OutputStream&) const;
+    void writeDecodedImageFunctionDeclaration (OutputStream&) const;
+    void writeDecodedImageFunction (OutputStream&) const;
+    void writePackLoader (OutputStream&) const;
+    void writePackResourceDeclaration (int fileIndex, OutputStream&) const;
+    void writePackDataDeclaration (const File&, int fileIndex, OutputStream&) const;
+    String getDataExpression (int fileIndex) const;
+    String getNamedResourceReturnCode (int fileIndex) const;
+    Result writePackFile();
 
     template <ProjucerVersion>
     Result writeHeader (MemoryOutputStream&);
     template <ProjucerVersion>
-    Result writeCpp (MemoryOutputStream&, const File& headerFile, int& index, int maxFileSize);
+    Result writeCpp (OutputStream&, const File& headerFile, int& index, int maxFileSize);
 };
 
 
@@ -0,0 +1,196 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../jucer_Headers.h"
+#include "jucer_ResourceFileCache.h"
+
+#include "jucer_MappedResourceFile.h"
+#include "../Utility/jucer_ContentHash.h"
+
+#include <set>
+
+
+// Must be changed whenever CodeHelpers::writeDataAsCppLiteral() writes something else
+static const char* const cacheIndexHeader = "FRUT BinaryDataCache 1";
+
+
+ResourceFileCache::ResourceFileCache(const File& cacheDirectory)
+  : cacheDir{cacheDirectory}
+{
+  cacheDir.createDirectory();
+
+  StringArray lines;
+  cacheDir.getChildFile("index").readLines(lines);
+
+  if (lines.isEmpty() || lines[0] != cacheIndexHeader)
+  {
+    return;
+  }
+
+  for (auto i = 1; i < lines.size(); ++i)
+  {
+    // <content-hash> <size> <modification-time>\t<full-path>
+    const auto& line = lines.getReference(i);
+    const auto tokens = StringArray::fromTokens(
+      line.upToFirstOccurrenceOf("\t", false, false), " ", {});
+    const auto path = line.fromFirstOccurrenceOf("\t", false, false);
+
+    if (tokens.size() != 3 || path.isEmpty())
+    {
+      continue;
+    }
+
+    previousEntries[path] = Entry{tokens[1].getLargeIntValue(),
+                                  tokens[2].getLargeIntValue(),
+                                  static_cast<uint64>(tokens[0].getHexValue64())};
+  }
+}
+
+
+void ResourceFileCache::writeDataAsCppLiteral(const File& resourceFile, OutputStream& out)
+{
+  const auto path = resourceFile.getFullPathName();
+  const auto size = resourceFile.getSize();
+  const auto modificationTime = resourceFile.getLastModificationTime().toMilliseconds();
+
+  const auto previousEntry = previousEntries.find(path);
+  if (previousEntry != previousEntries.end() && previousEntry->second.size == size
+      && previousEntry->second.modificationTime == modificationTime
+      && readLiteral(previousEntry->second.contentHash, out))
+  {
+    addUsedEntry(path, previousEntry->second);
+    return;
+  }
+
+  const MappedResourceFile data{resourceFile};
+  if (!data.openedOk())
+  {
+    return;
+  }
+
+  const auto entry =
+    Entry{size, modificationTime, ContentHash::compute(data.getData(), data.getSize())};
+
+  // The resource file might have been touched without being modified, or another
+  // resource file might have the same content
+  if (readLiteral(entry.contentHash, out))
+  {
+    addUsedEntry(path, entry);
+    return;
+  }
+
+  // The literal is written to the cache first and then copied, so that it doesn't have to
+  // fit in memory
+  if (writeLiteral(entry.contentHash, data) && readLiteral(entry.contentHash, out))
+  {
+    addUsedEntry(path, entry);
+    return;
+  }
+
+  CodeHelpers::writeDataAsCppLiteral(data.getData(), data.getSize(), out, true, true);
+}
+
+
+bool ResourceFileCache::save() const
+{
+  MemoryOutputStream index;
+  index << cacheIndexHeader << "\n";
+
+  std::set<String> usedLiteralFileNames;
+
+  for (const auto& pathAndEntry : usedEntries)
+  {
+    const auto& entry = pathAndEntry.second;
+    index << ContentHash::toHexString(entry.contentHash) << " " << entry.size << " "
+          << entry.modificationTime << "\t" << pathAndEntry.first << "\n";
+
+    usedLiteralFileNames.insert(getLiteralFile(entry.contentHash).getFileName());
+  }
+
+  if (!FileHelpers::overwriteFileWithNewDataIfDifferent(cacheDir.getChildFile("index"),
+                                                        index))
+  {
+    return false;
+  }
+
+  Array<File> literalFiles;
+  cacheDir.findChildFiles(literalFiles, File::findFiles, false, "*.inc");
+
+  for (const auto& literalFile : literalFiles)
+  {
+    if (usedLiteralFileNames.count(literalFile.getFileName()) == 0)
+    {
+      literalFile.deleteFile();
+    }
+  }
+
+  return true;
+}
+
+
+void ResourceFileCache::addUsedEntry(const String& path, const Entry& entry)
+{
+  const std::lock_guard<std::mutex> lock{usedEntriesMutex};
+  usedEntries[path] = entry;
+}
+
+
+File ResourceFileCache::getLiteralFile(uint64 contentHash) const
+{
+  return cacheDir.getChildFile(ContentHash::toHexString(contentHash) + ".inc");
+}
+
+
+bool ResourceFileCache::writeLiteral(uint64 contentHash,
+                                     const MappedResourceFile& data) const
+{
+  TemporaryFile temporaryFile{getLiteralFile(contentHash)};
+
+  {
+    FileOutputStream literal{temporaryFile.getFile()};
+    if (!literal.openedOk())
+    {
+      return false;
+    }
+
+    CodeHelpers::writeDataAsCppLiteral(data.getData(), data.getSize(), literal, true, true);
+
+    literal.flush();
+    if (literal.getStatus().failed())
+    {
+      return false;
+    }
+  }
+
+  return temporaryFile.overwriteTargetFileWithTemporary();
+}
+
+
+bool ResourceFileCache::readLiteral(uint64 contentHash, OutputStream& out) const
+{
+  // Literal files are moved to the cache directory once they are complete, so they are
+  // either complete or missing
+  FileInputStream literal{getLiteralFile(contentHash)};
+
+  if (!literal.openedOk())
+  {
+    return false;
+  }
+
+  const auto size = literal.getTotalLength();
+  return out.writeFromInputStream(literal, -1) == size;
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+
+
+class MappedResourceFile;
+
+
+// Stores the C++ literals written by CodeHelpers::writeDataAsCppLiteral() in a directory,
+// so that they don't have to be encoded again when the resource files didn't change.
+//
+// The literals are stored in one file per content hash. An index maps the full path of
+// each resource file to its size, modification time and content hash, so that resource
+// files that weren't modified don't even have to be read.
+class ResourceFileCache
+{
+public:
+  explicit ResourceFileCache(const File& cacheDirectory);
+
+  // Can be called concurrently from several threads
+  void writeDataAsCppLiteral(const File& resourceFile, OutputStream& out);
+
+  // Writes the index and deletes the literals that weren't written by
+  // writeDataAsCppLiteral() since the cache was loaded
+  bool save() const;
+
+private:
+  struct Entry
+  {
+    int64 size;
+    int64 modificationTime;
+    uint64 contentHash;
+  };
+
+  void addUsedEntry(const String& path, const Entry&);
+  File getLiteralFile(uint64 contentHash) const;
+  bool writeLiteral(uint64 contentHash, const MappedResourceFile&) const;
+  bool readLiteral(uint64 contentHash, OutputStream&) const;
+
+  const File cacheDir;
+  std::map<String, Entry> previousEntries;
+  std::map<String, Entry> usedEntries;
+  std::mutex usedEntriesMutex;
+};
@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2019  Alain Martin
+// Copyright (C) 2016-2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -49,6 +49,22 @@ public:
     return binaryDataFilesOuputDir.getChildFile("BinaryData.h");
   }
 
+  File getBinaryDataObjectFile() const
+  {
+    return binaryDataFilesOuputDir.getChildFile("BinaryData.o");
+  }
+
+  File getBinaryDataPackFile() const
+  {
+    return binaryDataFilesOuputDir.getChildFile("BinaryData.pack");
+  }
+
+  File getBinaryDataCompressedFile(const String& name) const
+  {
+    return binaryDataFilesOuputDir.getChildFile("BinaryDataCompressed")
+      .getChildFile(name + ".zlib");
+  }
+
 private:
   const File binaryDataFilesOuputDir;
   const String projectUID;
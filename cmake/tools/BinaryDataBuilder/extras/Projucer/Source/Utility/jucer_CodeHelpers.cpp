@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2018  Alain Martin
+// Copyright (C) 2017-2018, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,7 +17,7 @@
 
 // clang-format off
 
-// Lines 24-243 of this file were copied from
+// Lines 24-50, 56-118, 398-399, 406-408, 410, 412-413, 415, 417-418, 420, 423-439, 444-445, 447-450, 452-490, and 671 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/4.2.0/extras/Projucer/Source/Utility/jucer_CodeHelpers.cpp
 
 
@@ -48,6 +48,11 @@
 #include "../jucer_Headers.h"
 #include "jucer_CodeHelpers.h"
 
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
 
 //==============================================================================
 namespace CodeHelpers
@@ -111,69 +116,310 @@ namespace CodeHelpers
                                     false, true, false);
     }
 
-    void writeDataAsCppLiteral (const MemoryBlock& mb, OutputStream& out,
-                                bool breakAtNewLines, bool allowStringBreaks)
+    // The literal is formatted into a fixed-size buffer which is written to the output
+    // stream in bulk, instead of going through OutputStream (and String, for numbers) for
+    // every byte of the resource
+    class LiteralBuffer
     {
-        const int maxCharsOnLine = 250;
+    public:
+        explicit LiteralBuffer (OutputStream& o)
+            : out (o), newLineString (o.getNewLineString().toRawUTF8()),
+              newLineLength (strlen (newLineString.toRawUTF8())), buffer (bufferSize)
+        {
+        }
+
+        ~LiteralBuffer()
+        {
+            flush();
+        }
+
+        // Returns a pointer to at least maxLength bytes of free space
+        char* reserve (size_t maxLength)
+        {
+            jassert (maxLength <= bufferSize);
+
+            if (numUsed + maxLength > bufferSize)
+                flush();
+
+            return buffer + numUsed;
+        }
+
+        void commit (size_t length)
+        {
+            numUsed += length;
+        }
+
+        void write (const char* text, size_t length)
+        {
+            memcpy (reserve (length), text, length);
+            commit (length);
+        }
+
+        void write (char c)
+        {
+            *reserve (1) = c;
+            commit (1);
+        }
+
+        void writeNewLine()
+        {
+            write (newLineString.toRawUTF8(), newLineLength);
+        }
+
+    private:
+        void flush()
+        {
+            if (numUsed > 0)
+                out.write (buffer, numUsed);
+
+            numUsed = 0;
+        }
+
+        static const size_t bufferSize = 64 * 1024;
+
+        OutputStream& out;
+        const String newLineString;
+        const size_t newLineLength;
+        HeapBlock<char> buffer;
+        size_t numUsed = 0;
+    };
+
+    // "d,", "dd," or "ddd," for each byte value, padded to 4 chars so that the entries can
+    // be copied with a fixed size
+    struct ByteLiteralTable
+    {
+        ByteLiteralTable()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                char* text = entries[i];
+                int length = 0;
+
+                if (i >= 100)  text[length++] = (char) ('0' + i / 100);
+                if (i >= 10)   text[length++] = (char) ('0' + (i / 10) % 10);
+
+                text[length++] = (char) ('0' + i % 10);
+                text[length++] = ',';
+
+                while (length < 4)
+                    text[length++] = 0;
+
+                lengths[i] = (uint8) (i >= 100 ? 4 : (i >= 10 ? 3 : 2));
+            }
+        }
+
+        char entries[256][4];
+        uint8 lengths[256];
+    };
+
+    static const ByteLiteralTable& getByteLiteralTable()
+    {
+        static const ByteLiteralTable table;
+        return table;
+    }
+
+    static bool isPrintable (unsigned char c) noexcept
+    {
+        return c >= 32 && c < 127;
+    }
+
+    static bool isHexDigit (unsigned char c) noexcept
+    {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
 
-        const unsigned char* data = (const unsigned char*) mb.getData();
+    static bool needsEscaping (unsigned char c) noexcept
+    {
+        return ! (isPrintable (c) || c == '\t' || c == '\r' || c == '\n');
+    }
+
+    static bool hasFewEscapedChars (const unsigned char* data, size_t size)
+    {
+        const size_t maxNumEscaped = size / 4;
+        size_t numEscaped = 0;
+        size_t i = 0;
+
+        // Most text resources are plain ASCII, so 8 bytes are checked at once, and only the
+        // words containing a byte outside of [32, 126] are checked byte by byte
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64 word;
+            memcpy (&word, data + i, sizeof (word));
+
+            const uint64 ones = 0x0101010101010101ULL;
+            const uint64 topBits = 0x8080808080808080ULL;
+
+            if (((word | (word - ones * 32)) & topBits) != 0)
+            {
+                for (size_t j = i; j < i + 8; ++j)
+                    if (needsEscaping (data[j]) && ++numEscaped > maxNumEscaped)
+                        return false;
+            }
+            else
+            {
+                // 127 (DEL) is the only byte in [32, 127] that needs escaping
+                const uint64 delBytes = word ^ (ones * 127);
+
+                if (((delBytes - ones) & ~delBytes & topBits) != 0)
+                    for (size_t j = i; j < i + 8; ++j)
+                        if (data[j] == 127 && ++numEscaped > maxNumEscaped)
+                            return false;
+            }
+        }
+
+        for (; i < size; ++i)
+            if (needsEscaping (data[i]) && ++numEscaped > maxNumEscaped)
+                return false;
+
+        return true;
+    }
+
+    static void writeNumericArrayLiteral (const unsigned char* data, size_t size,
+                                          LiteralBuffer& buffer, int maxCharsOnLine)
+    {
+        const ByteLiteralTable& table = getByteLiteralTable();
         int charsOnLine = 0;
 
-        bool canUseStringLiteral = mb.getSize() < 32768; // MS compilers can't handle big string literals..
+        buffer.write ("{ ", 2);
 
-        if (canUseStringLiteral)
+        for (size_t i = 0; i < size; ++i)
         {
-            unsigned int numEscaped = 0;
+            const unsigned char num = data[i];
+            const int length = table.lengths[num];
+
+            memcpy (buffer.reserve (4), table.entries[num], 4);
+            buffer.commit ((size_t) length);
+
+            charsOnLine += length;
 
-            for (size_t i = 0; i < mb.getSize(); ++i)
+            if (charsOnLine >= maxCharsOnLine)
             {
-                const unsigned int num = (unsigned int) data[i];
-                if (! ((num >= 32 && num < 127) || num == '\t' || num == '\r' || num == '\n'))
-                {
-                    if (++numEscaped > mb.getSize() / 4)
-                    {
-                        canUseStringLiteral = false;
-                        break;
-                    }
-                }
+                charsOnLine = 0;
+                buffer.writeNewLine();
             }
         }
 
-        if (! canUseStringLiteral)
+        buffer.write ("0,0 };", 6);
+    }
+
+    // Same output as CppTokeniserFunctions::writeEscapeChars() with replaceSingleQuotes
+    // set to false
+    static void writeEscapedStringLiteral (const unsigned char* data, size_t size,
+                                           LiteralBuffer& buffer, int maxCharsOnLine,
+                                           bool breakAtNewLines, bool allowStringBreaks)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+
+        int charsOnLine = 0;
+        bool lastWasHexEscapeCode = false;
+        bool trigraphDetected = false;
+
+        buffer.write ('"');
+
+        for (size_t i = 0; i < size; ++i)
         {
-            out << "{ ";
+            const unsigned char c = data[i];
+            bool startNewLine = false;
 
-            for (size_t i = 0; i < mb.getSize(); ++i)
+            switch (c)
             {
-                const int num = (int) (unsigned int) data[i];
-                out << num << ',';
+                case '\t':  buffer.write ("\\t", 2);  trigraphDetected = false; lastWasHexEscapeCode = false; charsOnLine += 2; break;
+                case '\r':  buffer.write ("\\r", 2);  trigraphDetected = false; lastWasHexEscapeCode = false; charsOnLine += 2; break;
+                case '\n':  buffer.write ("\\n", 2);  trigraphDetected = false; lastWasHexEscapeCode = false; charsOnLine += 2; startNewLine = breakAtNewLines; break;
+                case '\\':  buffer.write ("\\\\", 2); trigraphDetected = false; lastWasHexEscapeCode = false; charsOnLine += 2; break;
+                case '\"':  buffer.write ("\\\"", 2); trigraphDetected = false; lastWasHexEscapeCode = false; charsOnLine += 2; break;
+
+                case '?':
+                    if (trigraphDetected)
+                    {
+                        buffer.write ("\\?", 2);
+                        charsOnLine++;
+                        trigraphDetected = false;
+                    }
+                    else
+                    {
+                        buffer.write ('?');
+                        trigraphDetected = true;
+                    }
 
-                charsOnLine += 2;
+                    lastWasHexEscapeCode = false;
+                    charsOnLine++;
+                    break;
 
-                if (num >= 10)
-                {
-                    ++charsOnLine;
+                case 0:
+                    buffer.write ("\\0", 2);
+                    lastWasHexEscapeCode = true;
+                    trigraphDetected = false;
+                    charsOnLine += 2;
+                    break;
 
-                    if (num >= 100)
+                default:
+                    if (isPrintable (c) && ! (lastWasHexEscapeCode && isHexDigit (c)))
+                    {
+                        buffer.write ((char) c);
+                        lastWasHexEscapeCode = false;
+                        trigraphDetected = false;
                         ++charsOnLine;
-                }
+                    }
+                    else if (allowStringBreaks && lastWasHexEscapeCode && isPrintable (c))
+                    {
+                        const char text[] = { '"', '"', (char) c };
+                        buffer.write (text, sizeof (text));
+                        lastWasHexEscapeCode = false;
+                        trigraphDetected = false;
+                        charsOnLine += 3;
+                    }
+                    else
+                    {
+                        const char text[] = { '\\', 'x', hexDigits[c >> 4], hexDigits[c & 15] };
+                        buffer.write (text, sizeof (text));
+                        lastWasHexEscapeCode = true;
+                        trigraphDetected = false;
+                        charsOnLine += 4;
+                    }
 
-                if (charsOnLine >= maxCharsOnLine)
-                {
-                    charsOnLine = 0;
-                    out << newLine;
-                }
+                    break;
             }
 
-            out << "0,0 };";
+            if ((startNewLine || (maxCharsOnLine > 0 && charsOnLine >= maxCharsOnLine))
+                 && i < size - 1)
+            {
+                charsOnLine = 0;
+                buffer.write ('"');
+                buffer.writeNewLine();
+                buffer.write ('"');
+                lastWasHexEscapeCode = false;
+            }
         }
+
+        buffer.write ("\";", 2);
+    }
+
+    void writeDataAsCppLiteral (const MemoryBlock& mb, OutputStream& out,
+                                bool breakAtNewLines, bool allowStringBreaks)
+    {
+        writeDataAsCppLiteral (mb.getData(), mb.getSize(), out, breakAtNewLines, allowStringBreaks);
+    }
+
+    void writeDataAsCppLiteral (const void* dataToWrite, size_t size, OutputStream& out,
+                                bool breakAtNewLines, bool allowStringBreaks)
+    {
+        const int maxCharsOnLine = 250;
+
+        const unsigned char* data = (const unsigned char*) dataToWrite;
+
+        bool canUseStringLiteral = size < 32768; // MS compilers can't handle big string literals..
+
+        if (canUseStringLiteral)
+            canUseStringLiteral = hasFewEscapedChars (data, size);
+
+        LiteralBuffer buffer (out);
+
+        if (! canUseStringLiteral)
+            writeNumericArrayLiteral (data, size, buffer, maxCharsOnLine);
         else
-        {
-            out << "\"";
-            CppTokeniserFunctions::writeEscapeChars (out, (const char*) data, (int) mb.getSize(),
-                                                     maxCharsOnLine, breakAtNewLines, false, allowStringBreaks);
-            out << "\";";
-        }
+            writeEscapedStringLiteral (data, size, buffer, maxCharsOnLine,
+                                       breakAtNewLines, allowStringBreaks);
     }
 
     //==============================================================================
@@ -191,20 +437,22 @@ namespace CodeHelpers
     {
         unsigned int v = 31;
 
+        // SortedSet::add() is linear, which made each attempt quadratic
+        std::unordered_set<unsigned int> hashes;
+        hashes.reserve ((size_t) strings.size());
+
         for (;;)
         {
-            SortedSet <unsigned int> hashes;
+            hashes.clear();
             bool collision = false;
             for (int i = strings.size(); --i >= 0;)
             {
                 const unsigned int hash = calculateHash (strings[i], v);
-                if (hashes.contains (hash))
+                if (! hashes.insert (hash).second)
                 {
                     collision = true;
                     break;
                 }
-
-                hashes.add (hash);
             }
 
             if (! collision)
@@ -240,4 +488,184 @@ namespace CodeHelpers
         out << indent << "    default: break;" << newLine
             << indent << "}" << newLine << newLine;
     }
+
+    //==============================================================================
+    // 64-bit FNV-1a, computed the same way by the code written by createPerfectHashStringMatcher()
+    static uint64 calculatePerfectHashKey (const String& s)
+    {
+        uint64 key = 14695981039346656037ULL;
+
+        for (const char* t = s.toUTF8(); *t != 0; ++t)
+            key = (key ^ (uint64) (unsigned char) *t) * 1099511628211ULL;
+
+        return key;
+    }
+
+    static unsigned int calculatePerfectHashSlot (const uint64 key, const unsigned int displacement,
+                                                  const unsigned int numSlots)
+    {
+        uint64 x = key ^ (displacement * 0x9e3779b97f4a7c15ULL);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+
+        return (unsigned int) (x % numSlots);
+    }
+
+    // "Hash, displace, and compress" (Belazzougui, Botelho and Dietzfelbinger, 2009), without the
+    // compression: the keys are split into buckets of about 4 keys, then the buckets are placed from
+    // the biggest to the smallest, by finding for each bucket a displacement that sends all its keys to
+    // free slots. There are as many slots as keys, so the hash function is minimal.
+    static bool findPerfectHash (const std::vector<uint64>& keys,
+                                 std::vector<unsigned int>& displacements,
+                                 std::vector<int>& slotToKey)
+    {
+        const unsigned int numKeys = (unsigned int) keys.size();
+        const unsigned int numBuckets = jmax (1u, numKeys / 4);
+
+        {
+            // Two identical keys would never end up in different slots
+            std::vector<uint64> sortedKeys (keys);
+            std::sort (sortedKeys.begin(), sortedKeys.end());
+
+            if (std::adjacent_find (sortedKeys.begin(), sortedKeys.end()) != sortedKeys.end())
+                return false;
+        }
+
+        std::vector<std::vector<int>> buckets (numBuckets);
+
+        for (unsigned int i = 0; i < numKeys; ++i)
+            buckets[(size_t) ((keys[i] >> 32) % numBuckets)].push_back ((int) i);
+
+        std::vector<unsigned int> bucketOrder (numBuckets);
+
+        for (unsigned int i = 0; i < numBuckets; ++i)
+            bucketOrder[i] = i;
+
+        std::stable_sort (bucketOrder.begin(), bucketOrder.end(), [&buckets] (unsigned int a, unsigned int b)
+        {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        displacements.assign (numBuckets, 0);
+        slotToKey.assign (numKeys, -1);
+
+        const unsigned int maxDisplacement = 1u << 24;
+        std::vector<unsigned int> bucketSlots;
+
+        for (auto bucketIndex : bucketOrder)
+        {
+            const auto& bucket = buckets[bucketIndex];
+
+            if (bucket.empty())
+                break;
+
+            for (unsigned int displacement = 0;; ++displacement)
+            {
+                if (displacement == maxDisplacement)
+                    return false;
+
+                bucketSlots.clear();
+
+                for (auto keyIndex : bucket)
+                {
+                    const unsigned int slot = calculatePerfectHashSlot (keys[(size_t) keyIndex], displacement, numKeys);
+
+                    if (slotToKey[slot] != -1
+                         || std::find (bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end())
+                        break;
+
+                    bucketSlots.push_back (slot);
+                }
+
+                if (bucketSlots.size() == bucket.size())
+                {
+                    for (size_t i = 0; i < bucket.size(); ++i)
+                        slotToKey[bucketSlots[i]] = bucket[i];
+
+                    displacements[bucketIndex] = displacement;
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void createPerfectHashStringMatcher (OutputStream& out, const String& utf8PointerVariable,
+                                         const StringArray& strings, const StringArray& codeToExecute, const int indentLevel)
+    {
+        jassert (strings.size() == codeToExecute.size());
+
+        std::vector<uint64> keys;
+
+        for (int i = 0; i < strings.size(); ++i)
+            keys.push_back (calculatePerfectHashKey (strings[i]));
+
+        std::vector<unsigned int> displacements;
+        std::vector<int> slotToString;
+
+        if (strings.isEmpty() || ! findPerfectHash (keys, displacements, slotToString))
+        {
+            createStringMatcher (out, utf8PointerVariable, strings, codeToExecute, indentLevel);
+            return;
+        }
+
+        const String indent (String::repeatedString (" ", indentLevel));
+
+        out << indent << "static const unsigned int hashDisplacements[] =" << newLine
+            << indent << "{";
+
+        for (size_t i = 0; i < displacements.size(); ++i)
+        {
+            if (i % 16 == 0)
+                out << newLine << indent << "   ";
+
+            out << " " << (int) displacements[i] << ",";
+        }
+
+        out << newLine
+            << indent << "};" << newLine
+            << newLine
+            << indent << "static const char* const hashedStrings[] =" << newLine
+            << indent << "{" << newLine;
+
+        for (auto stringIndex : slotToString)
+            out << indent << "    " << strings[stringIndex].quoted() << "," << newLine;
+
+        out << indent << "};" << newLine
+            << newLine
+            << indent << "if (" << utf8PointerVariable << " != 0)" << newLine
+            << indent << "{" << newLine
+            << indent << "    unsigned long long key = 14695981039346656037ull;" << newLine
+            << indent << "    for (const char* c = " << utf8PointerVariable << "; *c != 0; ++c)" << newLine
+            << indent << "        key = (key ^ (unsigned char) *c) * 1099511628211ull;" << newLine
+            << newLine
+            << indent << "    unsigned long long x = key ^ (hashDisplacements[(key >> 32) % " << (int) displacements.size() << "u] * 0x9e3779b97f4a7c15ull);" << newLine
+            << indent << "    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;" << newLine
+            << indent << "    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;" << newLine
+            << indent << "    x ^= x >> 31;" << newLine
+            << indent << "    const unsigned int slot = (unsigned int) (x % " << (int) slotToString.size() << "u);" << newLine
+            << newLine
+            << indent << "    const char* s = hashedStrings[slot];" << newLine
+            << indent << "    const char* c = " << utf8PointerVariable << ";" << newLine
+            << indent << "    while (*c != 0 && *c == *s)" << newLine
+            << indent << "    {" << newLine
+            << indent << "        ++c;" << newLine
+            << indent << "        ++s;" << newLine
+            << indent << "    }" << newLine
+            << newLine
+            << indent << "    if (*c == *s)" << newLine
+            << indent << "    {" << newLine
+            << indent << "        switch (slot)" << newLine
+            << indent << "        {" << newLine;
+
+        for (size_t slot = 0; slot < slotToString.size(); ++slot)
+            out << indent << "            case " << (int) slot << ":  " << codeToExecute[slotToString[slot]] << newLine;
+
+        out << indent << "            default: break;" << newLine
+            << indent << "        }" << newLine
+            << indent << "    }" << newLine
+            << indent << "}" << newLine << newLine;
+    }
 }
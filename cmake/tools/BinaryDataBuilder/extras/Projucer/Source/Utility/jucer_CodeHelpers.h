@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2019  Alain Martin
+// Copyright (C) 2017-2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,7 +17,7 @@
 
 // clang-format off
 
-// Lines 24-66 of this file were copied from
+// Lines 24-60, 64-66, and 71-74 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/4.2.0/extras/Projucer/Source/Utility/jucer_CodeHelpers.h
 
 
@@ -58,8 +58,16 @@ namespace CodeHelpers
     void writeDataAsCppLiteral (const MemoryBlock& data, OutputStream& out,
                                 bool breakAtNewLines, bool allowStringBreaks);
 
+    void writeDataAsCppLiteral (const void* data, size_t size, OutputStream& out,
+                                bool breakAtNewLines, bool allowStringBreaks);
+
     void createStringMatcher (OutputStream& out, const String& utf8PointerVariable,
                               const StringArray& strings, const StringArray& codeToExecute, const int indentLevel);
+
+    // Like createStringMatcher(), but the generated code looks the string up in a minimal perfect
+    // hash table, so that it takes the same time whatever the number of strings
+    void createPerfectHashStringMatcher (OutputStream& out, const String& utf8PointerVariable,
+                                         const StringArray& strings, const StringArray& codeToExecute, const int indentLevel);
 }
 
 
@@ -0,0 +1,130 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+
+// Implementation of the xxHash64 algorithm (https://github.com/Cyan4973/xxHash), which is
+// a lot faster than FileHelpers::calculateStreamHashCode() on big resource files
+namespace ContentHash
+{
+
+namespace detail
+{
+
+constexpr uint64 prime1 = 11400714785074694791ULL;
+constexpr uint64 prime2 = 14029467366897019727ULL;
+constexpr uint64 prime3 = 1609587929392839161ULL;
+constexpr uint64 prime4 = 9650029242287828579ULL;
+constexpr uint64 prime5 = 2870177450012600261ULL;
+
+inline uint64 rotateLeft(uint64 value, int bits)
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64 round(uint64 accumulator, uint64 input)
+{
+  accumulator += input * prime2;
+  accumulator = rotateLeft(accumulator, 31);
+  return accumulator * prime1;
+}
+
+inline uint64 mergeRound(uint64 accumulator, uint64 value)
+{
+  accumulator ^= round(0, value);
+  return accumulator * prime1 + prime4;
+}
+
+} // namespace detail
+
+
+inline uint64 compute(const void* data, size_t size, uint64 seed = 0)
+{
+  using namespace detail;
+
+  auto p = static_cast<const uint8*>(data);
+  const auto end = p + size;
+  auto hash = uint64{};
+
+  if (size >= 32)
+  {
+    auto v1 = seed + prime1 + prime2;
+    auto v2 = seed + prime2;
+    auto v3 = seed;
+    auto v4 = seed - prime1;
+
+    for (const auto limit = end - 32; p <= limit; p += 32)
+    {
+      v1 = round(v1, ByteOrder::littleEndianInt64(p));
+      v2 = round(v2, ByteOrder::littleEndianInt64(p + 8));
+      v3 = round(v3, ByteOrder::littleEndianInt64(p + 16));
+      v4 = round(v4, ByteOrder::littleEndianInt64(p + 24));
+    }
+
+    hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+    hash = mergeRound(hash, v1);
+    hash = mergeRound(hash, v2);
+    hash = mergeRound(hash, v3);
+    hash = mergeRound(hash, v4);
+  }
+  else
+  {
+    hash = seed + prime5;
+  }
+
+  hash += static_cast<uint64>(size);
+
+  for (; p + 8 <= end; p += 8)
+  {
+    hash ^= round(0, ByteOrder::littleEndianInt64(p));
+    hash = rotateLeft(hash, 27) * prime1 + prime4;
+  }
+
+  if (p + 4 <= end)
+  {
+    hash ^= static_cast<uint64>(ByteOrder::littleEndianInt(p)) * prime1;
+    hash = rotateLeft(hash, 23) * prime2 + prime3;
+    p += 4;
+  }
+
+  for (; p < end; ++p)
+  {
+    hash ^= static_cast<uint64>(*p) * prime5;
+    hash = rotateLeft(hash, 11) * prime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= prime2;
+  hash ^= hash >> 29;
+  hash *= prime3;
+  hash ^= hash >> 32;
+
+  return hash;
+}
+
+inline uint64 compute(const MemoryBlock& data)
+{
+  return compute(data.getData(), data.getSize());
+}
+
+inline String toHexString(uint64 hash)
+{
+  return String::toHexString(static_cast<int64>(hash)).paddedLeft('0', 16);
+}
+
+} // namespace ContentHash
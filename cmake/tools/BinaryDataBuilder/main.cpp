@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2020  Alain Martin
+// Copyright (C) 2016-2020, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,32 +17,61 @@
 
 #include "extras/Projucer/Source/jucer_Headers.h"
 
+#include "extras/Projucer/Source/Project Saving/jucer_ElfObjectWriter.h"
 #include "extras/Projucer/Source/Project Saving/jucer_ResourceFile.h"
 
-#include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
 
-int main(int argc, char* argv[])
+namespace
+{
+
+void printUsage(std::ostream& err)
+{
+  err << "usage: BinaryDataBuilder"
+      << " <Projucer-version>"
+      << " <BinaryData-files-output-dir>"
+      << " <Project-UID>"
+      << " <BinaryData.cpp-size-limit>"
+      << " <BinaryData-namespace>"
+      << " [--shards=<number-of-shards>]"
+      << " [--shard-plan=<shard-plan-file> [--plan-only]]"
+      << " [--cache-dir=<cache-dir>]"
+      << " [--jobs=<number-of-threads>]"
+      << " [--backend=<literals|incbin|elf|pack> [--elf-machine=<machine>]]"
+      << " [--alignment=<alignment>]"
+      << " [--compress]"
+      << " [--deduplicate]"
+      << " [--lookup=<switch|perfect-hash>]"
+      << " [--constexpr-index]"
+      << " [--content-hashes]"
+      << " [--decoded-images]"
+      << " [--file-list=<file-list-file>]"
+      << " <resource-files>...\n"
+      << "       BinaryDataBuilder --manifest=<manifest-file>" << std::endl;
+}
+
+
+// Writes the BinaryData files of one project. args are the same as the command-line
+// arguments (args.at(0) being the name of the program), and the list of BinaryData files
+// is written to out, unless --file-list is given.
+int buildBinaryData(const std::vector<std::string>& args,
+                    int defaultNumberOfThreads,
+                    std::ostream& out,
+                    std::ostream& err)
 {
-  if (argc < 5)
-  {
-    std::cerr << "usage: BinaryDataBuilder"
-              << " <Projucer-version>"
-              << " <BinaryData-files-output-dir>"
-              << " <Project-UID>"
-              << " <BinaryData.cpp-size-limit>"
-              << " <BinaryData-namespace>"
-              << " <resource-files>..." << std::endl;
+  if (args.size() < 6)
+  {
+    printUsage(err);
     return 1;
   }
 
-  const std::vector<std::string> args{argv, argv + argc};
-
   using Version = std::tuple<int, int, int>;
 
   const auto jucerVersion = [&args]() {
@@ -54,8 +83,7 @@ int main(int argc, char* argv[])
     const auto versionTokens = StringArray::fromTokens(String{args.at(1)}, ".", {});
     if (versionTokens.size() != 3)
     {
-      std::cerr << "Invalid Projucer version" << std::endl;
-      std::exit(1);
+      return Version{};
     }
 
     try
@@ -64,60 +92,423 @@ int main(int argc, char* argv[])
                      std::stoi(versionTokens[1].toStdString()),
                      std::stoi(versionTokens[2].toStdString())};
     }
-    catch (const std::invalid_argument&)
+    catch (const std::logic_error&)
     {
-      std::cerr << "Invalid Projucer version" << std::endl;
-      std::exit(1);
+      return Version{};
     }
   }();
 
+  if (jucerVersion == Version{})
+  {
+    err << "Invalid Projucer version" << std::endl;
+    return 1;
+  }
+
   Project project{args.at(2), args.at(3)};
 
-  const auto maxSize = [&args]() {
-    try
+  auto maxSize = 0;
+  try
+  {
+    maxSize = std::stoi(args.at(4));
+  }
+  catch (const std::logic_error&)
+  {
+    err << "Invalid size limit" << std::endl;
+    return 1;
+  }
+
+  ResourceFile resourceFile{project};
+  resourceFile.setClassName(args.at(5));
+  resourceFile.setNumberOfThreads(defaultNumberOfThreads);
+
+  const auto shardsOption = std::string{"--shards="};
+  const auto shardPlanOption = std::string{"--shard-plan="};
+  const auto cacheDirOption = std::string{"--cache-dir="};
+  const auto jobsOption = std::string{"--jobs="};
+  const auto backendOption = std::string{"--backend="};
+  const auto elfMachineOption = std::string{"--elf-machine="};
+  const auto alignmentOption = std::string{"--alignment="};
+  const auto lookupOption = std::string{"--lookup="};
+  const auto fileListOption = std::string{"--file-list="};
+  auto shardPlanFile = File{};
+  auto fileListFile = File{};
+  auto backend = BinaryDataBackend::cppLiterals;
+  auto elfMachine = String{};
+  auto numShards = 0;
+  auto planOnly = false;
+  auto deduplicate = false;
+
+  for (auto i = 6u; i < args.size(); ++i)
+  {
+    const auto& arg = args.at(i);
+
+    if (arg.compare(0, shardsOption.size(), shardsOption) == 0)
+    {
+      try
+      {
+        numShards = std::stoi(arg.substr(shardsOption.size()));
+      }
+      catch (const std::logic_error&)
+      {
+        numShards = 0;
+      }
+
+      if (numShards <= 0)
+      {
+        err << "Invalid number of shards" << std::endl;
+        return 1;
+      }
+
+      resourceFile.setNumberOfShards(numShards);
+    }
+    else if (arg.compare(0, shardPlanOption.size(), shardPlanOption) == 0)
     {
-      return std::stoi(args.at(4));
+      shardPlanFile = File::getCurrentWorkingDirectory().getChildFile(
+        String{arg.substr(shardPlanOption.size())});
     }
-    catch (const std::invalid_argument&)
+    else if (arg.compare(0, cacheDirOption.size(), cacheDirOption) == 0)
     {
-      std::cerr << "Invalid size limit" << std::endl;
-      std::exit(1);
+      resourceFile.setCacheDirectory(File::getCurrentWorkingDirectory().getChildFile(
+        String{arg.substr(cacheDirOption.size())}));
     }
-  }();
+    else if (arg.compare(0, jobsOption.size(), jobsOption) == 0)
+    {
+      try
+      {
+        resourceFile.setNumberOfThreads(std::stoi(arg.substr(jobsOption.size())));
+      }
+      catch (const std::logic_error&)
+      {
+        err << "Invalid number of jobs" << std::endl;
+        return 1;
+      }
+    }
+    else if (arg.compare(0, backendOption.size(), backendOption) == 0)
+    {
+      const auto backendName = arg.substr(backendOption.size());
+      if (backendName == "literals")
+      {
+        backend = BinaryDataBackend::cppLiterals;
+      }
+      else if (backendName == "incbin")
+      {
+        backend = BinaryDataBackend::incbin;
+      }
+      else if (backendName == "elf")
+      {
+        backend = BinaryDataBackend::elfObject;
+      }
+      else if (backendName == "pack")
+      {
+        backend = BinaryDataBackend::pack;
+      }
+      else
+      {
+        err << "Invalid backend: " << backendName << std::endl;
+        return 1;
+      }
+    }
+    else if (arg.compare(0, elfMachineOption.size(), elfMachineOption) == 0)
+    {
+      elfMachine = arg.substr(elfMachineOption.size());
+    }
+    else if (arg.compare(0, alignmentOption.size(), alignmentOption) == 0)
+    {
+      auto alignment = 0;
+      try
+      {
+        alignment = std::stoi(arg.substr(alignmentOption.size()));
+      }
+      catch (const std::logic_error&)
+      {
+        alignment = 0;
+      }
 
-  ResourceFile resourceFile{project};
-  resourceFile.setClassName(args.at(5));
+      if (alignment <= 0 || !isPowerOfTwo(alignment)
+          || alignment > ResourceFile::maxAlignment)
+      {
+        err << "Invalid alignment, it must be a power of 2 between 1 and "
+            << ResourceFile::maxAlignment << std::endl;
+        return 1;
+      }
 
-  for (auto i = 6u; i < args.size(); ++i)
+      resourceFile.setAlignment(alignment);
+    }
+    else if (arg == "--plan-only")
+    {
+      planOnly = true;
+    }
+    else if (arg == "--compress")
+    {
+      resourceFile.setCompressResources(true);
+    }
+    else if (arg == "--decoded-images")
+    {
+      resourceFile.setHasDecodedImages(true);
+    }
+    else if (arg == "--constexpr-index")
+    {
+      resourceFile.setUseConstexprIndex(true);
+    }
+    else if (arg == "--content-hashes")
+    {
+      resourceFile.setEmitContentHashes(true);
+    }
+    else if (arg == "--deduplicate")
+    {
+      deduplicate = true;
+      resourceFile.setDeduplicateResources(true);
+    }
+    else if (arg.compare(0, fileListOption.size(), fileListOption) == 0)
+    {
+      fileListFile = File::getCurrentWorkingDirectory().getChildFile(
+        String{arg.substr(fileListOption.size())});
+    }
+    else if (arg.compare(0, lookupOption.size(), lookupOption) == 0)
+    {
+      const auto lookupName = arg.substr(lookupOption.size());
+      if (lookupName == "switch" || lookupName == "perfect-hash")
+      {
+        resourceFile.setUsePerfectHashLookup(lookupName == "perfect-hash");
+      }
+      else
+      {
+        err << "Invalid lookup: " << lookupName << std::endl;
+        return 1;
+      }
+    }
+    else if (arg.compare(0, 2, "--") == 0)
+    {
+      err << "Unknown option: " << arg << std::endl;
+      return 1;
+    }
+    else
+    {
+      resourceFile.addFile(File{arg});
+    }
+  }
+
+  if (planOnly && shardPlanFile == File{})
   {
-    resourceFile.addFile(File{args.at(i)});
+    err << "--plan-only requires --shard-plan" << std::endl;
+    return 1;
   }
 
+  if (backend == BinaryDataBackend::elfObject
+      && !ElfObjectWriter::isSupportedMachine(elfMachine))
+  {
+    err << "--backend=elf requires --elf-machine=<x86|x86_64|arm64>" << std::endl;
+    return 1;
+  }
+
+  if (numShards > 0 && backend != BinaryDataBackend::cppLiterals)
+  {
+    err << "--shards requires --backend=literals" << std::endl;
+    return 1;
+  }
+
+  resourceFile.setBackend(backend);
+  resourceFile.setElfMachine(elfMachine);
+
   Array<File> binaryDataFiles;
 
-  const auto result =
-    jucerVersion < Version{5, 0, 0}
-      ? resourceFile.write<ProjucerVersion::v4_2_0>(binaryDataFiles, maxSize)
-      : jucerVersion < Version{5, 3, 1}
-          ? resourceFile.write<ProjucerVersion::v5_0_0>(binaryDataFiles, maxSize)
-          : resourceFile.write<ProjucerVersion::v5_3_1>(binaryDataFiles, maxSize);
+  if (planOnly)
+  {
+    const auto shardPlan = resourceFile.computeShardPlan(maxSize);
+
+    MemoryOutputStream planStream;
+    for (const auto numFiles : shardPlan)
+    {
+      planStream << numFiles << "\n";
+    }
+
+    if (!FileHelpers::overwriteFileWithNewDataIfDifferent(shardPlanFile, planStream))
+    {
+      err << "Can't write to file: " << shardPlanFile.getFullPathName() << std::endl;
+      return 1;
+    }
 
-  if (!result.wasOk())
+    binaryDataFiles.add(project.getBinaryDataHeaderFile());
+    for (auto i = 0; i < shardPlan.size(); ++i)
+    {
+      binaryDataFiles.add(project.getBinaryDataCppFile(i));
+    }
+    if (backend == BinaryDataBackend::elfObject)
+    {
+      binaryDataFiles.add(project.getBinaryDataObjectFile());
+    }
+    if (backend == BinaryDataBackend::pack)
+    {
+      binaryDataFiles.add(project.getBinaryDataPackFile());
+    }
+  }
+  else
   {
-    std::cerr << result.getErrorMessage() << std::endl;
-    return 1;
+    if (shardPlanFile != File{})
+    {
+      Array<int> shardPlan;
+      for (const auto& line : StringArray::fromLines(shardPlanFile.loadFileAsString()))
+      {
+        if (line.trim().isNotEmpty())
+        {
+          shardPlan.add(line.getIntValue());
+        }
+      }
+
+      const auto planResult = resourceFile.setShardPlan(shardPlan);
+      if (!planResult.wasOk())
+      {
+        err << planResult.getErrorMessage() << std::endl;
+        return 1;
+      }
+    }
+
+    const auto result =
+      jucerVersion < Version{5, 0, 0}
+        ? resourceFile.write<ProjucerVersion::v4_2_0>(binaryDataFiles, maxSize)
+        : jucerVersion < Version{5, 3, 1}
+            ? resourceFile.write<ProjucerVersion::v5_0_0>(binaryDataFiles, maxSize)
+            : resourceFile.write<ProjucerVersion::v5_3_1>(binaryDataFiles, maxSize);
+
+    if (!result.wasOk())
+    {
+      err << result.getErrorMessage() << std::endl;
+      return 1;
+    }
+
+    // out is reserved for the list of BinaryData files
+    if (deduplicate)
+    {
+      err << "BinaryDataBuilder: " << resourceFile.getNumDeduplicatedBytes()
+          << " bytes saved by deduplicating resource files" << std::endl;
+    }
   }
 
+  MemoryOutputStream fileList;
   for (auto i = 0; i < binaryDataFiles.size(); ++i)
   {
     if (i != 0)
     {
-      std::cout << ";";
+      fileList << ";";
     }
 
-    std::cout << binaryDataFiles.getUnchecked(i).getFileName();
+    fileList << binaryDataFiles.getUnchecked(i).getFileName();
+  }
+
+  if (fileListFile != File{})
+  {
+    if (!FileHelpers::overwriteFileWithNewDataIfDifferent(fileListFile, fileList))
+    {
+      err << "Can't write to file: " << fileListFile.getFullPathName() << std::endl;
+      return 1;
+    }
+  }
+  else
+  {
+    out << fileList.toString() << std::flush;
   }
-  std::cout << std::flush;
 
   return 0;
 }
+
+
+// A manifest contains the arguments of several jobs, one argument per line. Jobs are
+// separated by empty lines. Since the arguments are read from a file, the number of
+// resource files isn't limited by the maximum length of a command line.
+std::vector<std::vector<std::string>> readManifest(const File& manifestFile)
+{
+  std::vector<std::vector<std::string>> jobs{1};
+
+  StringArray lines;
+  manifestFile.readLines(lines);
+
+  for (const auto& line : lines)
+  {
+    if (line.isEmpty())
+    {
+      if (!jobs.back().empty())
+      {
+        jobs.emplace_back();
+      }
+      continue;
+    }
+
+    if (jobs.back().empty())
+    {
+      jobs.back().push_back("BinaryDataBuilder");
+    }
+    jobs.back().push_back(line.toStdString());
+  }
+
+  if (jobs.back().empty())
+  {
+    jobs.pop_back();
+  }
+
+  return jobs;
+}
+
+
+// The jobs of a manifest are processed concurrently, each of them on a single thread
+// unless it has a --jobs argument. Their output is printed once they are all done, in
+// the order of the manifest.
+int buildBinaryDataFromManifest(const File& manifestFile)
+{
+  if (!manifestFile.existsAsFile())
+  {
+    std::cerr << "Can't open manifest file: " << manifestFile.getFullPathName()
+              << std::endl;
+    return 1;
+  }
+
+  const auto jobs = readManifest(manifestFile);
+
+  std::vector<std::ostringstream> outputs(jobs.size());
+  std::vector<std::ostringstream> errors(jobs.size());
+  std::vector<int> results(jobs.size(), 0);
+
+  // Each job only writes the elements of outputs, errors and results at its index
+  parallelFor(static_cast<int>(std::thread::hardware_concurrency()),
+              static_cast<int>(jobs.size()), [&](int i) {
+                results[i] = buildBinaryData(jobs[i], 1, outputs[i], errors[i]);
+                return Result::ok();
+              });
+
+  auto result = 0;
+  for (auto i = size_t{0}; i < jobs.size(); ++i)
+  {
+    std::cout << outputs[i].str();
+
+    if (!errors[i].str().empty())
+    {
+      std::cerr << (jobs[i].size() > 2 ? jobs[i][2] + ": " : "") << errors[i].str();
+    }
+
+    if (results[i] != 0)
+    {
+      result = 1;
+    }
+  }
+  std::cout << std::flush;
+
+  return result;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+  const std::vector<std::string> args{argv, argv + argc};
+
+  const auto manifestOption = std::string{"--manifest="};
+  if (args.size() == 2
+      && args.at(1).compare(0, manifestOption.size(), manifestOption) == 0)
+  {
+    return buildBinaryDataFromManifest(File::getCurrentWorkingDirectory().getChildFile(
+      String{args.at(1).substr(manifestOption.size())}));
+  }
+
+  return buildBinaryData(args, static_cast<int>(std::thread::hardware_concurrency()),
+                         std::cout, std::cerr);
+}
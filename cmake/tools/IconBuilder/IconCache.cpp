@@ -0,0 +1,97 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "IconCache.h"
+
+#include "../ImageDecoder/DecodedImage.h"
+
+
+// Must be changed whenever ProjectExporter::rescaleImageForIcon() renders something else
+static const char* const renderingVersion = "2";
+
+
+IconCache::IconCache(const File& directory)
+  : cacheDir{directory}
+{
+  cacheDir.createDirectory();
+}
+
+
+String IconCache::computeSourceHash(const File& sourceFile)
+{
+  MemoryBlock data;
+  sourceFile.loadFileAsData(data);
+  data.append(renderingVersion, strlen(renderingVersion));
+
+  return MD5{data}.toHexString();
+}
+
+
+Image IconCache::getImage(const String& sourceHash,
+                          int size,
+                          const std::function<Image()>& render)
+{
+  const auto key = std::make_pair(sourceHash, size);
+
+  // When several outputs need the same image at the same time, only the first one loads
+  // or renders it, and the others wait for it
+  std::shared_future<Image> cachedImage;
+  std::promise<Image> imagePromise;
+
+  {
+    const std::lock_guard<std::mutex> lock{imagesMutex};
+
+    const auto entry = images.find(key);
+    if (entry != images.end())
+    {
+      cachedImage = entry->second;
+    }
+    else
+    {
+      images[key] = imagePromise.get_future().share();
+    }
+  }
+
+  if (cachedImage.valid())
+  {
+    return cachedImage.get();
+  }
+
+  const auto cachedImageFile = getCachedImageFile(sourceHash, size);
+
+  MemoryBlock data;
+  auto image = cachedImageFile.loadFileAsData(data)
+                 ? DecodedImage::read(data.getData(), data.getSize())
+                 : Image{};
+
+  if (!image.isValid())
+  {
+    image = render();
+
+    // Decoded images are always ARGB, so other images are only kept in memory
+    if (image.isValid() && image.getFormat() == Image::ARGB)
+    {
+      const auto decodedImage = DecodedImage::write(image);
+      FileHelpers::overwriteFileWithNewDataIfDifferent(
+        cachedImageFile, decodedImage.getData(), decodedImage.getSize());
+    }
+  }
+
+  imagePromise.set_value(image);
+
+  return image;
+}
@@ -0,0 +1,58 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Source/jucer_Headers.h"
+
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <utility>
+
+
+// Keeps the images rendered from the icons in memory and in a directory, so that an icon
+// isn't rendered again at the same size as long as its source file doesn't change. The
+// images are stored as decoded images (see DecodedImage.h in ImageDecoder), since writing
+// them as PNG files wouldn't preserve premultiplied pixels exactly.
+class IconCache
+{
+public:
+  explicit IconCache(const File& directory);
+
+  // Returns a hash of the content of an icon source file, which changes as well when the
+  // rendering code changes
+  static String computeSourceHash(const File& sourceFile);
+
+  // Returns the image of the given size rendered from the icon whose source file has the
+  // given hash, and only calls render if it isn't cached yet. Can be called concurrently.
+  Image getImage(const String& sourceHash,
+                 int size,
+                 const std::function<Image()>& render);
+
+  // Deletes the cached images of the icon source files that don't have one of the given
+  // hashes
+  void removeOtherSources(const StringArray& sourceHashes) const;
+
+private:
+  File getCachedImageFile(const String& sourceHash, int size) const;
+
+  const File cacheDir;
+  std::mutex imagesMutex;
+  std::map<std::pair<String, int>, std::shared_future<Image>> images;
+};
@@ -0,0 +1,187 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_graphics/juce_graphics.h>
+
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUT_ICON_DOWNSCALER_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define FRUT_ICON_DOWNSCALER_USE_SSE2 0
+#endif
+
+
+// Downscales icon images like ProjectExporter::rescaleImageForIcon() did with repeated
+// calls to juce::Image::rescaled(), but each image is only halved once: the halved images
+// are kept in a mip chain, which is then sampled for every requested icon size.
+//
+// The icons look the same, but they are NOT byte-identical to the ones written by
+// Projucer, since the halved images are computed by averaging 2x2 blocks of pixels instead
+// of with juce::Image::rescaled().
+namespace IconDownscaler
+{
+
+// Averages each 2x2 block of premultiplied ARGB pixels of source. The last row and column
+// of source are dropped when its height and width are odd, whereas
+// juce::Image::rescaled(width / 2, height / 2) would resample the whole image, so the
+// pixels of odd-sized images are slightly shifted compared to it.
+inline juce::Image halve(const juce::Image& source)
+{
+  const auto argbSource = source.convertedToFormat(juce::Image::ARGB);
+  const auto width = argbSource.getWidth() / 2;
+  const auto height = argbSource.getHeight() / 2;
+
+  juce::Image halved{juce::Image::ARGB, width, height, false,
+                     juce::SoftwareImageType{}};
+
+  const juce::Image::BitmapData src{argbSource, juce::Image::BitmapData::readOnly};
+  const juce::Image::BitmapData dst{halved, juce::Image::BitmapData::writeOnly};
+
+  for (auto y = 0; y < height; ++y)
+  {
+    const auto row0 = src.getLinePointer(2 * y);
+    const auto row1 = src.getLinePointer(2 * y + 1);
+    const auto out = dst.getLinePointer(y);
+
+    auto x = 0;
+
+#if FRUT_ICON_DOWNSCALER_USE_SSE2
+    // 4 source pixels of each row give 2 halved pixels
+    const auto zero = _mm_setzero_si128();
+    const auto rounding = _mm_set1_epi16(2);
+
+    for (; x + 2 <= width; x += 2)
+    {
+      const auto pixels0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 8 * x));
+      const auto pixels1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 8 * x));
+
+      // Vertical sums of source pixels 0 and 1, and of source pixels 2 and 3
+      const auto sums01 = _mm_add_epi16(_mm_unpacklo_epi8(pixels0, zero),
+                                        _mm_unpacklo_epi8(pixels1, zero));
+      const auto sums23 = _mm_add_epi16(_mm_unpackhi_epi8(pixels0, zero),
+                                        _mm_unpackhi_epi8(pixels1, zero));
+
+      const auto sums = _mm_add_epi16(_mm_unpacklo_epi64(sums01, sums23),
+                                      _mm_unpackhi_epi64(sums01, sums23));
+      const auto averages = _mm_srli_epi16(_mm_add_epi16(sums, rounding), 2);
+
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 4 * x),
+                       _mm_packus_epi16(averages, averages));
+    }
+#endif
+
+    for (; x < width; ++x)
+    {
+      for (auto channel = 0; channel < 4; ++channel)
+      {
+        const auto sum = row0[8 * x + channel] + row0[8 * x + 4 + channel]
+                         + row1[8 * x + channel] + row1[8 * x + 4 + channel];
+        out[4 * x + channel] = static_cast<juce::uint8>((sum + 2) / 4);
+      }
+    }
+  }
+
+  return halved;
+}
+
+
+class MipChain
+{
+public:
+  explicit MipChain(const juce::Image& source)
+  {
+    levels.push_back(juce::SoftwareImageType{}.convert(source));
+
+    while (levels.back().getWidth() >= 2 && levels.back().getHeight() >= 2)
+    {
+      levels.push_back(halve(levels.back()));
+    }
+  }
+
+  // Returns the source image if it has the requested size. Otherwise, draws the first level
+  // that isn't more than twice as big as the requested size in both dimensions (or the
+  // last level) within a transparent image of the requested size.
+  juce::Image getImage(int size) const
+  {
+    const auto& source = levels.front();
+
+    if (size == source.getWidth() && size == source.getHeight())
+    {
+      return source;
+    }
+
+    auto level = levels.begin();
+    while (std::next(level) != levels.end() && level->getWidth() > 2 * size
+           && level->getHeight() > 2 * size)
+    {
+      ++level;
+    }
+
+    juce::Image image{juce::Image::ARGB, size, size, true, juce::SoftwareImageType{}};
+    juce::Graphics g{image};
+    g.drawImageWithin(*level, 0, 0, size, size,
+                      juce::RectanglePlacement::centred
+                        | juce::RectanglePlacement::onlyReduceInSize,
+                      false);
+    return image;
+  }
+
+private:
+  std::vector<juce::Image> levels;
+};
+
+
+// The mip chain of an image is built the first time it is rescaled, and kept until the
+// process exits. Copies of a juce::DrawableImage share the pixel data of their image, so
+// they share the mip chain too. Can be called concurrently.
+inline juce::Image rescale(const juce::Image& source, int size)
+{
+  static std::mutex mipChainsMutex;
+  // The source images are kept alive, so that their pixel data can't be reused for other
+  // images
+  static std::map<juce::ImagePixelData*,
+                  std::pair<juce::Image, std::shared_ptr<const MipChain>>>
+    mipChains;
+
+  std::shared_ptr<const MipChain> mipChain;
+
+  {
+    const std::lock_guard<std::mutex> lock{mipChainsMutex};
+
+    auto& cachedMipChain = mipChains[source.getPixelData()];
+    if (cachedMipChain.second == nullptr)
+    {
+      cachedMipChain = {source, std::make_shared<const MipChain>(source)};
+    }
+    mipChain = cachedMipChain.second;
+  }
+
+  return mipChain->getImage(size);
+}
+
+} // namespace IconDownscaler
@@ -0,0 +1,41 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+
+// Replaces juce::ScopedJuceInitialiser_GUI in IconBuilder, which only loads Drawables
+// and renders them into software images. Neither needs the message manager, which
+// juce::ScopedJuceInitialiser_GUI creates and which connects to the X server on Linux.
+// The singletons created while rendering (like the typeface cache) are still deleted
+// when going out of scope, like in juce::shutdownJuce_GUI().
+class ScopedJuceInitialiser_Headless
+{
+public:
+  ScopedJuceInitialiser_Headless() = default;
+
+  ~ScopedJuceInitialiser_Headless()
+  {
+    juce::DeletedAtShutdown::deleteAll();
+  }
+
+  ScopedJuceInitialiser_Headless(const ScopedJuceInitialiser_Headless&) = delete;
+  ScopedJuceInitialiser_Headless&
+  operator=(const ScopedJuceInitialiser_Headless&) = delete;
+};
@@ -1,4 +1,4 @@
-// Copyright (C) 2017, 2019  Alain Martin
+// Copyright (C) 2017, 2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,7 +17,7 @@
 
 // clang-format off
 
-// Lines 24-108 of this file were copied from
+// Lines 24-51, 54-84, 86-88, and 91-97 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/5.3.2/extras/Projucer/Source/ProjectSaving/jucer_ProjectExporter.cpp
 
 
@@ -49,6 +49,8 @@
 
 #include "jucer_ProjectExporter.h"
 
+#include "../../IconDownscaler.h"
+
 
 Image ProjectExporter::getBestIconForSize (int size, bool returnNullIfNothingBigEnough) const
 {
@@ -80,25 +82,12 @@ Image ProjectExporter::getBestIconForSize (int size, bool returnNullIfNothingBig
     return rescaleImageForIcon (*im, size);
 }
 
-Image ProjectExporter::rescaleImageForIcon (Drawable& d, const int size)
+Image ProjectExporter::renderImageForIcon (Drawable& d, const int size)
 {
     if (auto* drawableImage = dynamic_cast<DrawableImage*> (&d))
     {
-        auto im = SoftwareImageType().convert (drawableImage->getImage());
-
-        if (size == im.getWidth() && size == im.getHeight())
-            return im;
-
-        // (scale it down in stages for better resampling)
-        while (im.getWidth() > 2 * size && im.getHeight() > 2 * size)
-            im = im.rescaled (im.getWidth() / 2,
-                              im.getHeight() / 2);
-
-        Image newIm (Image::ARGB, size, size, true, SoftwareImageType());
-        Graphics g (newIm);
-        g.drawImageWithin (im, 0, 0, size, size,
-                           RectanglePlacement::centred | RectanglePlacement::onlyReduceInSize, false);
-        return newIm;
+        // (scale it down in stages for better resampling, from a mip chain built once)
+        return IconDownscaler::rescale (drawableImage->getImage(), size);
     }
 
     Image im (Image::ARGB, size, size, true, SoftwareImageType());
@@ -106,3 +95,46 @@ Image ProjectExporter::rescaleImageForIcon (Drawable& d, const int size)
     d.drawWithin (g, im.getBounds().toFloat(), RectanglePlacement::centred, 1.0f);
     return im;
 }
+
+// The Drawable of an icon file has the hash of the file as component ID, which is copied
+// along with it, so that rescaleImageForIcon() knows which icon file it comes from
+std::unique_ptr<Drawable> ProjectExporter::copyIcon (const File& iconFile, IconSource& source)
+{
+    std::call_once (source.loadedFlag, [&iconFile, &source]
+    {
+        source.drawable = std::unique_ptr<Drawable> (Drawable::createFromImageFile (iconFile));
+
+        if (source.drawable != nullptr)
+            source.drawable->setComponentID (IconCache::computeSourceHash (iconFile));
+    });
+
+    if (source.drawable == nullptr)
+        return nullptr;
+
+    std::unique_ptr<Drawable> copy (source.drawable->createCopy());
+    copy->setComponentID (source.drawable->getComponentID());
+    return copy;
+}
+
+StringArray ProjectExporter::getIconSourceHashes() const
+{
+    StringArray hashes;
+
+    if (auto smallIcon = getSmallIcon())
+        hashes.addIfNotAlreadyThere (smallIcon->getComponentID());
+
+    if (auto bigIcon = getBigIcon())
+        hashes.addIfNotAlreadyThere (bigIcon->getComponentID());
+
+    return hashes;
+}
+
+Image ProjectExporter::rescaleImageForIcon (Drawable& d, const int size)
+{
+    const String sourceHash (d.getComponentID());
+
+    if (sIconCache == nullptr || sourceHash.isEmpty())
+        return renderImageForIcon (d, size);
+
+    return sIconCache->getImage (sourceHash, size, [&d, size] { return renderImageForIcon (d, size); });
+}
@@ -1,4 +1,4 @@
-// Copyright (C) 2017, 2019  Alain Martin
+// Copyright (C) 2017, 2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -19,7 +19,10 @@
 
 #include "../jucer_Headers.h"
 
+#include "../../IconCache.h"
+
 #include <memory>
+#include <mutex>
 
 
 class ProjectExporter
@@ -32,24 +35,50 @@ public:
   {
   }
 
+  // Each icon file is only loaded once, and each call returns a copy of it, so that the
+  // icons can be rendered concurrently
   std::unique_ptr<Drawable> getBigIcon() const
   {
-    return std::unique_ptr<Drawable>{Drawable::createFromImageFile(mBigIcon)};
+    return copyIcon(mBigIcon, mBigIconSource);
   }
 
   std::unique_ptr<Drawable> getSmallIcon() const
   {
-    return std::unique_ptr<Drawable>{Drawable::createFromImageFile(mSmallIcon)};
+    return copyIcon(mSmallIcon, mSmallIconSource);
   }
 
+  StringArray getIconSourceHashes() const;
+
   Image getBestIconForSize(int size, bool returnNullIfNothingBigEnough) const;
 
+  // Gets the image from the IconCache set with setIconCache() when the Drawable comes from
+  // getSmallIcon() or getBigIcon(), and renders it with renderImageForIcon() otherwise
   static Image rescaleImageForIcon(Drawable&, int iconSize);
 
+  static Image renderImageForIcon(Drawable&, int iconSize);
+
+  static void setIconCache(IconCache* cache)
+  {
+    sIconCache = cache;
+  }
+
 #include "jucer_ProjectExport_MSVC.h"
 #include "jucer_ProjectExport_XCode.h"
+#include "jucer_ProjectExport_Xcode_iOS.h"
 
 private:
+  struct IconSource
+  {
+    std::once_flag loadedFlag;
+    std::unique_ptr<Drawable> drawable;
+  };
+
+  static std::unique_ptr<Drawable> copyIcon(const File& iconFile, IconSource& source);
+
   const File mSmallIcon;
   const File mBigIcon;
+  mutable IconSource mSmallIconSource;
+  mutable IconSource mBigIconSource;
+
+  static inline IconCache* sIconCache = nullptr;
 };
@@ -1,4 +1,4 @@
-// Copyright (C) 2017, 2019  Alain Martin
+// Copyright (C) 2017, 2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,7 +17,7 @@
 
 // clang-format off
 
-// Lines 24-87 and 89-108 of this file were copied from
+// Lines 24-87 and 89-114 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/4.2.0/extras/Projucer/Source/Utility/jucer_FileHelpers.cpp
 
 
@@ -105,4 +105,10 @@ namespace FileHelpers
     {
         return overwriteFileWithNewDataIfDifferent (file, newData.getData(), newData.getDataSize());
     }
+
+    bool overwriteFileWithNewDataIfDifferent (const File& file, const String& newData)
+    {
+        const char* const utf8 = newData.toUTF8();
+        return overwriteFileWithNewDataIfDifferent (file, utf8, strlen (utf8));
+    }
 }
@@ -1,4 +1,4 @@
-// Copyright (C) 2017, 2019  Alain Martin
+// Copyright (C) 2017, 2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,7 +17,7 @@
 
 // clang-format off
 
-// Lines 24-63 of this file were copied from
+// Lines 24-64 of this file were copied from
 // https://github.com/juce-framework/JUCE/blob/4.2.0/extras/Projucer/Source/Utility/jucer_FileHelpers.h
 
 
@@ -57,6 +57,7 @@ namespace FileHelpers
 
     bool overwriteFileWithNewDataIfDifferent (const File& file, const void* data, size_t numBytes);
     bool overwriteFileWithNewDataIfDifferent (const File& file, const MemoryOutputStream& newData);
+    bool overwriteFileWithNewDataIfDifferent (const File& file, const String& newData);
 }
 
 
@@ -0,0 +1,177 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../Source/jucer_Headers.h"
+
+#include "../IconDownscaler.h"
+#include "../ScopedJuceInitialiser_Headless.h"
+#include "../Source/Project Saving/jucer_ProjectExporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+
+
+namespace
+{
+
+// What ProjectExporter::rescaleImageForIcon() did before using IconDownscaler
+Image rescaleWithImageRescaled(const Image& source, int size)
+{
+  auto im = SoftwareImageType{}.convert(source);
+
+  if (size == im.getWidth() && size == im.getHeight())
+  {
+    return im;
+  }
+
+  while (im.getWidth() > 2 * size && im.getHeight() > 2 * size)
+  {
+    im = im.rescaled(im.getWidth() / 2, im.getHeight() / 2);
+  }
+
+  Image newIm{Image::ARGB, size, size, true, SoftwareImageType{}};
+  Graphics g{newIm};
+  g.drawImageWithin(im, 0, 0, size, size,
+                    RectanglePlacement::centred | RectanglePlacement::onlyReduceInSize,
+                    false);
+  return newIm;
+}
+
+
+Image generateIcon(int size)
+{
+  const auto extent = static_cast<float>(size);
+
+  Image image{Image::ARGB, size, size, true, SoftwareImageType{}};
+  Graphics g{image};
+  g.setGradientFill(ColourGradient{Colours::orange, 0.0f, 0.0f, Colours::darkblue, extent,
+                                   extent, false});
+  g.fillRoundedRectangle(0.0f, 0.0f, extent, extent, extent / 5.0f);
+  g.setColour(Colours::white);
+  g.drawEllipse(image.getBounds().toFloat().reduced(extent / 4.0f), extent / 32.0f);
+  g.setFont(Font{extent / 4.0f, Font::bold});
+  g.drawText("FRUT", image.getBounds(), Justification::centred);
+  return image;
+}
+
+
+// Returns the largest difference between two channels of the same pixel of a and b
+int getMaxChannelDifference(const Image& a, const Image& b)
+{
+  const auto argbA = a.convertedToFormat(Image::ARGB);
+  const auto argbB = b.convertedToFormat(Image::ARGB);
+  const Image::BitmapData bitmapA{argbA, Image::BitmapData::readOnly};
+  const Image::BitmapData bitmapB{argbB, Image::BitmapData::readOnly};
+
+  auto maxDifference = 0;
+
+  for (auto y = 0; y < argbA.getHeight(); ++y)
+  {
+    const auto rowA = bitmapA.getLinePointer(y);
+    const auto rowB = bitmapB.getLinePointer(y);
+
+    for (auto i = 0; i < argbA.getWidth() * 4; ++i)
+    {
+      maxDifference = std::max(maxDifference, std::abs(rowA[i] - rowB[i]));
+    }
+  }
+
+  return maxDifference;
+}
+
+} // namespace
+
+
+// Measures how long it takes to rescale an icon to all the sizes of
+// ProjectExporter::getiOSAppIconTypes() (like ProjectExporter::createiOSIconFiles()
+// does), with repeated calls to Image::rescaled() and with an IconDownscaler::MipChain.
+// Without argument, a 2048x2048 icon is generated.
+int main(int argc, char* argv[])
+{
+  ScopedJuceInitialiser_Headless scopedJuceHeadless;
+
+  auto source = Image{};
+
+  if (argc > 1)
+  {
+    source =
+      ImageFileFormat::loadFrom(File::getCurrentWorkingDirectory().getChildFile(argv[1]));
+
+    if (!source.isValid())
+    {
+      std::cerr << "usage: IconDownscalerBenchmark [<icon-image-file>]" << std::endl;
+      return 1;
+    }
+  }
+  else
+  {
+    source = generateIcon(2048);
+  }
+
+  Array<int> sizes;
+  for (const auto& type : ProjectExporter::getiOSAppIconTypes())
+  {
+    sizes.add(type.size);
+  }
+
+  const auto numRuns = 10;
+
+  const auto benchmark = [&sizes](const char* name, const std::function<void()>& run) {
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < numRuns; ++i)
+    {
+      run();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto milliseconds =
+      std::chrono::duration<double, std::milli>(end - start).count() / numRuns;
+    std::cout << name << " (" << sizes.size() << " sizes): " << milliseconds
+              << " ms per icon set" << std::endl;
+  };
+
+  benchmark("Image::rescaled()", [&source, &sizes]() {
+    for (const auto& size : sizes)
+    {
+      rescaleWithImageRescaled(source, size);
+    }
+  });
+
+  // The mip chain is built in each run, like in each run of IconBuilder
+  benchmark("IconDownscaler::MipChain", [&source, &sizes]() {
+    const IconDownscaler::MipChain mipChain{source};
+    for (const auto& size : sizes)
+    {
+      mipChain.getImage(size);
+    }
+  });
+
+  const IconDownscaler::MipChain mipChain{source};
+  auto maxDifference = 0;
+  for (const auto& size : sizes)
+  {
+    const auto image = rescaleWithImageRescaled(source, size);
+    const auto difference = getMaxChannelDifference(image, mipChain.getImage(size));
+    maxDifference = std::max(maxDifference, difference);
+  }
+  std::cout << "Largest channel difference: " << maxDifference << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../Source/jucer_Headers.h"
+
+#include "../ScopedJuceInitialiser_Headless.h"
+#include "../Source/Project Saving/jucer_ProjectExporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+
+namespace
+{
+
+// Does what IconBuilder does for an ico file, with a generated PNG icon
+int renderIcon()
+{
+  Image icon{Image::ARGB, 256, 256, true, SoftwareImageType{}};
+
+  {
+    Graphics g{icon};
+    g.setColour(Colours::orange);
+    g.fillEllipse(icon.getBounds().toFloat());
+  }
+
+  MemoryOutputStream png;
+  PNGImageFormat{}.writeImageToStream(icon, png);
+
+  const auto drawable = std::unique_ptr<Drawable>(
+    Drawable::createFromImageData(png.getData(), png.getDataSize()));
+  if (drawable == nullptr)
+  {
+    return 1;
+  }
+
+  for (const auto& size : {16, 32, 48, 256})
+  {
+    if (!ProjectExporter::renderImageForIcon(*drawable, size).isValid())
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace
+
+
+// Measures how long it takes to run a process that renders an icon, when it initialises
+// JUCE with juce::ScopedJuceInitialiser_GUI (like IconBuilder 0.5.0 and before) and with
+// ScopedJuceInitialiser_Headless.
+int main(int argc, char* argv[])
+{
+  const auto childOption = String{"--child="};
+
+  if (argc == 2 && String{argv[1]}.startsWith(childOption))
+  {
+    if (String{argv[1]}.substring(childOption.length()) == "gui")
+    {
+      const ScopedJuceInitialiser_GUI scopedJuceGui;
+      return renderIcon();
+    }
+
+    const ScopedJuceInitialiser_Headless scopedJuceHeadless;
+    return renderIcon();
+  }
+
+  if (argc != 1)
+  {
+    std::cerr << "usage: StartupBenchmark" << std::endl;
+    return 1;
+  }
+
+  const auto executable =
+    File::getSpecialLocation(File::currentExecutableFile).getFullPathName();
+  const auto numRuns = 20;
+
+  for (const auto& mode : {"gui", "headless"})
+  {
+    auto totalMilliseconds = 0.0;
+    auto minMilliseconds = 0.0;
+
+    for (auto i = 0; i < numRuns; ++i)
+    {
+      const auto start = std::chrono::steady_clock::now();
+
+      ChildProcess child;
+      if (!child.start(StringArray{executable, childOption + mode})
+          || !child.waitForProcessToFinish(60000) || child.getExitCode() != 0)
+      {
+        std::cerr << "Can't run " << executable << " " << childOption << mode
+                  << std::endl;
+        return 1;
+      }
+
+      const auto end = std::chrono::steady_clock::now();
+
+      const auto milliseconds =
+        std::chrono::duration<double, std::milli>(end - start).count();
+      totalMilliseconds += milliseconds;
+      minMilliseconds = i == 0 ? milliseconds : std::min(minMilliseconds, milliseconds);
+    }
+
+    std::cout << mode << ": " << totalMilliseconds / numRuns << " ms per process (min "
+              << minMilliseconds << " ms)" << std::endl;
+  }
+
+  return 0;
+}
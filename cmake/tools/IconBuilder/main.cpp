@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2019  Alain Martin
+// Copyright (C) 2017-2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,34 +17,191 @@
 
 #include "Source/jucer_Headers.h"
 
+#include "IconCache.h"
+#include "ScopedJuceInitialiser_Headless.h"
 #include "Source/Project Saving/jucer_ProjectExporter.h"
-#include "Source/Utility/jucer_FileHelpers.h"
 
 #include <cstdlib>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 
+namespace
+{
+
+using Version = std::tuple<int, int, int>;
+
+
+void printUsage()
+{
+  std::cerr << "usage: IconBuilder"
+            << " <Projucer-version>"
+            << " <small-icon-image-file>"
+            << " <large-icon-image-file>"
+            << " <icon-cache-dir>"
+            << " [--icns=<icon-file-output-dir>]"
+            << " [--ico=<icon-file-output-dir>]"
+            << " [--xcassets=<xcassets-output-dir>]" << std::endl;
+}
+
+
+// Returns the file name of the written icon file, or an empty string if there is no icon
+String writeIcnsFile(const ProjectExporter& projectExporter,
+                     const Version& jucerVersion,
+                     const File& outputDir)
+{
+  OwnedArray<Drawable> images;
+
+  auto bigIcon = projectExporter.getBigIcon();
+  if (bigIcon)
+  {
+    images.add(bigIcon.release());
+  }
+
+  auto smallIcon = projectExporter.getSmallIcon();
+  if (smallIcon)
+  {
+    images.add(smallIcon.release());
+  }
+
+  if (images.size() == 0)
+  {
+    return {};
+  }
+
+  // Render the images concurrently, writeIcnsFile_*() then gets them from the IconCache
+  std::vector<std::future<Image>> renderedImages;
+  for (auto image : images)
+  {
+    renderedImages.push_back(std::async(std::launch::async, [image, &jucerVersion]() {
+      return jucerVersion < Version{5, 4, 0}
+               ? ProjectExporter::fixMacIconImageSize_v4_2_0(*image)
+               : ProjectExporter::fixMacIconImageSize_v5_4_0(*image);
+    }));
+  }
+  for (auto& renderedImage : renderedImages)
+  {
+    renderedImage.wait();
+  }
+
+  const auto iconFile = outputDir.getChildFile("Icon.icns");
+
+  MemoryOutputStream outStream;
+  if (jucerVersion < Version{5, 4, 0})
+  {
+    projectExporter.writeIcnsFile_v4_2_0(images, outStream);
+  }
+  else
+  {
+    projectExporter.writeIcnsFile_v5_4_0(images, outStream);
+  }
+
+  ProjectExporter::overwriteFileIfDifferentOrThrow(iconFile, outStream);
+
+  return iconFile.getFileName();
+}
+
+
+// Returns the file name of the written icon file, or an empty string if there is no icon
+String writeIcoFile(const ProjectExporter& projectExporter, const File& outputDir)
+{
+  std::vector<std::future<Image>> renderedImages;
+  for (const auto& size : {16, 32, 48, 256})
+  {
+    renderedImages.push_back(std::async(std::launch::async, [&projectExporter, size]() {
+      return projectExporter.getBestIconForSize(size, true);
+    }));
+  }
+
+  Array<Image> images;
+
+  for (auto& renderedImage : renderedImages)
+  {
+    const auto image = renderedImage.get();
+
+    if (image.isValid())
+    {
+      images.add(image);
+    }
+  }
+
+  if (images.size() == 0)
+  {
+    return {};
+  }
+
+  const auto iconFile = outputDir.getChildFile("icon.ico");
+
+  MemoryOutputStream outStream;
+  projectExporter.writeIconFile(images, outStream);
+
+  ProjectExporter::overwriteFileIfDifferentOrThrow(iconFile, outStream);
+
+  return iconFile.getFileName();
+}
+
+
+// Returns the full path of the written Images.xcassets bundle
+String writeXcassetsBundle(const ProjectExporter& projectExporter, const File& outputDir)
+{
+  const auto xcassetsBundle = outputDir.getChildFile("Images.xcassets");
+
+  const auto appiconsetBundle = xcassetsBundle.getChildFile("AppIcon.appiconset");
+  ProjectExporter::overwriteFileIfDifferentOrThrow(
+    appiconsetBundle.getChildFile("Contents.json"),
+    ProjectExporter::getiOSAppIconContents());
+  projectExporter.createiOSIconFiles(appiconsetBundle);
+
+  const auto launchimageBundle = xcassetsBundle.getChildFile("LaunchImage.launchimage");
+  ProjectExporter::overwriteFileIfDifferentOrThrow(
+    launchimageBundle.getChildFile("Contents.json"),
+    ProjectExporter::getiOSLaunchImageContents());
+  ProjectExporter::createiOSLaunchImageFiles(launchimageBundle);
+
+  return xcassetsBundle.getFullPathName();
+}
+
+
+String writeOutput(const String& output,
+                   const File& outputDir,
+                   const ProjectExporter& projectExporter,
+                   const Version& jucerVersion)
+{
+  if (output == "icns")
+  {
+    return writeIcnsFile(projectExporter, jucerVersion, outputDir);
+  }
+
+  if (output == "ico")
+  {
+    return writeIcoFile(projectExporter, outputDir);
+  }
+
+  return writeXcassetsBundle(projectExporter, outputDir);
+}
+
+} // namespace
+
+
+// Writes all the requested outputs concurrently, and prints one "<output>=<value>" line
+// for each of them, in the order of the arguments. The icon files are only loaded once,
+// and the images rendered for an output are reused by the other ones.
 int main(int argc, char* argv[])
 {
-  if (argc < 6)
-  {
-    std::cerr << "usage: IconBuilder"
-              << " <Projucer-version>"
-              << " <icon-format:icns,ico>"
-              << " <icon-file-output-dir>"
-              << " <small-icon-image-file>"
-              << " <large-icon-image-file>" << std::endl;
+  if (argc < 5)
+  {
+    printUsage();
     return 1;
   }
 
   const std::vector<std::string> args{argv, argv + argc};
 
-  using Version = std::tuple<int, int, int>;
-
   const auto jucerVersion = [&args]() {
     if (args.at(1) == "latest")
     {
@@ -71,94 +228,79 @@ int main(int argc, char* argv[])
     }
   }();
 
-  const auto& iconFormat = args.at(2);
-  const auto outputDir =
-    File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(3)});
   const auto smallIconImageFile =
-    args.at(4) == "<None>"
+    args.at(2) == "<None>"
       ? File{}
-      : File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(4)});
+      : File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(2)});
   const auto largeIconImageFile =
-    args.at(5) == "<None>"
+    args.at(3) == "<None>"
       ? File{}
-      : File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(5)});
+      : File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(3)});
+  const auto iconCacheDir =
+    File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(4)});
 
-  const ProjectExporter projectExporter{smallIconImageFile, largeIconImageFile};
-
-  juce::ScopedJuceInitialiser_GUI scopedJuceGui;
+  std::vector<std::pair<String, File>> outputs;
 
-  if (iconFormat == "icns")
+  for (auto i = size_t{5}; i < args.size(); ++i)
   {
-    OwnedArray<Drawable> images;
-
-    auto bigIcon = projectExporter.getBigIcon();
-    if (bigIcon)
-    {
-      images.add(bigIcon.release());
-    }
+    const auto arg = String{args.at(i)};
+    const auto output = arg.fromFirstOccurrenceOf("--", false, false)
+                          .upToFirstOccurrenceOf("=", false, false);
 
-    auto smallIcon = projectExporter.getSmallIcon();
-    if (smallIcon)
+    if (!arg.startsWith("--") || !arg.contains("=")
+        || !(output == "icns" || output == "ico" || output == "xcassets"))
     {
-      images.add(smallIcon.release());
+      std::cerr << "Unsupported output \"" << arg << "\"" << std::endl;
+      printUsage();
+      return 1;
     }
 
-    if (images.size() > 0)
-    {
-      const auto iconFile = outputDir.getChildFile("Icon.icns");
-
-      MemoryOutputStream outStream;
-      if (jucerVersion < Version{5, 4, 0})
-      {
-        projectExporter.writeIcnsFile_v4_2_0(images, outStream);
-      }
-      else
-      {
-        projectExporter.writeIcnsFile_v5_4_0(images, outStream);
-      }
-
-      if (!FileHelpers::overwriteFileWithNewDataIfDifferent(iconFile, outStream))
-      {
-        return 1;
-      }
-
-      std::cout << iconFile.getFileName() << std::flush;
-    }
+    outputs.emplace_back(output,
+                         File::getCurrentWorkingDirectory().getChildFile(
+                           arg.fromFirstOccurrenceOf("=", false, false)));
   }
-  else if (iconFormat == "ico")
-  {
-    Array<Image> images;
 
-    for (const auto& size : {16, 32, 48, 256})
-    {
-      const auto image = projectExporter.getBestIconForSize(size, true);
+  const ProjectExporter projectExporter{smallIconImageFile, largeIconImageFile};
 
-      if (image.isValid())
-      {
-        images.add(image);
-      }
-    }
+  ScopedJuceInitialiser_Headless scopedJuceHeadless;
 
-    if (images.size() > 0)
-    {
-      const auto iconFile = outputDir.getChildFile("icon.ico");
+  // The rendered images are cached across runs, so that the icons are only rendered again
+  // when the icon files change
+  IconCache iconCache{iconCacheDir};
+  ProjectExporter::setIconCache(&iconCache);
 
-      MemoryOutputStream outStream;
-      projectExporter.writeIconFile(images, outStream);
+  std::vector<std::future<String>> results;
 
-      if (!FileHelpers::overwriteFileWithNewDataIfDifferent(iconFile, outStream))
-      {
-        return 1;
-      }
+  for (const auto& output : outputs)
+  {
+    results.push_back(std::async(std::launch::async, writeOutput, output.first,
+                                 output.second, std::cref(projectExporter),
+                                 std::cref(jucerVersion)));
+  }
+
+  auto succeeded = true;
 
-      std::cout << iconFile.getFileName() << std::flush;
+  for (auto i = size_t{0}; i < outputs.size(); ++i)
+  {
+    try
+    {
+      std::cout << outputs[i].first << "=" << results[i].get() << "\n";
+    }
+    catch (const ProjectExporter::SaveError& error)
+    {
+      std::cerr << error.message << std::endl;
+      succeeded = false;
     }
   }
-  else
+
+  std::cout << std::flush;
+
+  if (!succeeded)
   {
-    std::cerr << "Unsupported icon format \"" << iconFormat << "\"" << std::endl;
     return 1;
   }
 
+  iconCache.removeOtherSources(projectExporter.getIconSourceHashes());
+
   return 0;
 }
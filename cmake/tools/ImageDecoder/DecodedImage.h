@@ -0,0 +1,95 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_graphics/juce_graphics.h>
+
+#include <cstring>
+
+
+// Images decoded by ImageDecoder are stored as a 24-byte header followed by the rows of
+// premultiplied ARGB pixels (in the byte order of juce::PixelARGB on little-endian
+// machines):
+//
+//   "FRUTIMG1", uint32 width, uint32 height, uint32 stride (bytes per row), uint32 zero
+//
+// All integers are little-endian. BinaryData.cpp contains a copy of readDecodedImage(),
+// written by BinaryDataBuilder, so that the generated code doesn't depend on this file.
+namespace DecodedImage
+{
+
+const auto headerSize = 24;
+
+inline juce::MemoryBlock write(const juce::Image& image)
+{
+  const auto argbImage = image.convertedToFormat(juce::Image::ARGB);
+  const auto width = argbImage.getWidth();
+  const auto height = argbImage.getHeight();
+  const auto stride = width * 4;
+
+  juce::MemoryOutputStream out;
+  out.write("FRUTIMG1", 8);
+  out.writeInt(width);
+  out.writeInt(height);
+  out.writeInt(stride);
+  out.writeInt(0);
+
+  const juce::Image::BitmapData bitmap{argbImage, juce::Image::BitmapData::readOnly};
+  for (auto y = 0; y < height; ++y)
+  {
+    out.write(bitmap.getLinePointer(y), static_cast<size_t>(stride));
+  }
+
+  return out.getMemoryBlock();
+}
+
+inline juce::Image read(const void* data, size_t dataSize)
+{
+  const auto bytes = static_cast<const char*>(data);
+
+  if (bytes == nullptr || dataSize < static_cast<size_t>(headerSize)
+      || std::memcmp(bytes, "FRUTIMG1", 8) != 0)
+  {
+    return {};
+  }
+
+  const auto width = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 8));
+  const auto height = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 12));
+  const auto stride = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 16));
+
+  if (width <= 0 || height <= 0 || stride < width * 4
+      || juce::int64{stride} * height > static_cast<juce::int64>(dataSize) - headerSize)
+  {
+    return {};
+  }
+
+  juce::Image image{juce::Image::ARGB, width, height, false};
+  const juce::Image::BitmapData bitmap{image, juce::Image::BitmapData::writeOnly};
+
+  for (auto y = 0; y < height; ++y)
+  {
+    std::memcpy(bitmap.getLinePointer(y),
+                bytes + headerSize + static_cast<size_t>(y) * static_cast<size_t>(stride),
+                static_cast<size_t>(width) * 4);
+  }
+
+  return image;
+}
+
+} // namespace DecodedImage
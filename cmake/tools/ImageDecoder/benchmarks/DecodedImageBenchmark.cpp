@@ -0,0 +1,122 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../DecodedImage.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+// Measures how long it takes to get the images of an editor as juce::Image objects, when
+// they are embedded as PNG files (decoded like ImageCache::getFromMemory() does) and when
+// they are embedded as decoded images. Without arguments, the images are generated.
+int main(int argc, char* argv[])
+{
+  juce::Array<juce::MemoryBlock> pngImages;
+
+  for (auto i = 1; i < argc; ++i)
+  {
+    const auto imageFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[i]);
+
+    juce::MemoryBlock data;
+    if (!imageFile.loadFileAsData(data))
+    {
+      std::cerr << "usage: DecodedImageBenchmark [<image-file> ...]" << std::endl;
+      return 1;
+    }
+    pngImages.add(data);
+  }
+
+  if (pngImages.isEmpty())
+  {
+    // Knobs, buttons and backgrounds of a typical plug-in editor
+    auto random = juce::Random{42};
+    const int sizes[] = {64, 64, 128, 128, 256, 256, 512, 1024};
+
+    for (auto i = 0; i < 40; ++i)
+    {
+      const auto size = sizes[i % juce::numElementsInArray(sizes)];
+      const auto extent = static_cast<float>(size);
+      const auto colour = juce::Colour{static_cast<juce::uint32>(random.nextInt())};
+      juce::Image image{juce::Image::ARGB, size, size, true};
+
+      {
+        juce::Graphics g{image};
+        g.setGradientFill(juce::ColourGradient{colour, 0.0f, 0.0f,
+                                               juce::Colours::transparentBlack, extent,
+                                               extent, true});
+        g.fillEllipse(0.0f, 0.0f, extent, extent);
+      }
+
+      juce::MemoryOutputStream png;
+      juce::PNGImageFormat{}.writeImageToStream(image, png);
+      pngImages.add(png.getMemoryBlock());
+    }
+  }
+
+  juce::Array<juce::MemoryBlock> decodedImages;
+  for (const auto& pngImage : pngImages)
+  {
+    decodedImages.add(DecodedImage::write(
+      juce::ImageFileFormat::loadFrom(pngImage.getData(), pngImage.getSize())));
+  }
+
+  const auto numEditorOpenings = 20;
+
+  using ImageLoader = juce::Image (*)(const juce::MemoryBlock&);
+
+  const auto benchmark = [](const char* name,
+                            const juce::Array<juce::MemoryBlock>& images,
+                            ImageLoader load) {
+    auto totalSize = size_t{0};
+    for (const auto& image : images)
+    {
+      totalSize += image.getSize();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < numEditorOpenings; ++i)
+    {
+      for (const auto& image : images)
+      {
+        if (!load(image).isValid())
+        {
+          std::cerr << "Can't load image" << std::endl;
+          std::exit(1);
+        }
+      }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto milliseconds =
+      std::chrono::duration<double, std::milli>(end - start).count() / numEditorOpenings;
+    std::cout << name << " (" << images.size() << " images, " << totalSize
+              << " bytes): " << milliseconds << " ms per editor opening" << std::endl;
+  };
+
+  benchmark("PNG", pngImages, [](const juce::MemoryBlock& data) {
+    return juce::ImageFileFormat::loadFrom(data.getData(), data.getSize());
+  });
+  benchmark("decoded", decodedImages, [](const juce::MemoryBlock& data) {
+    return DecodedImage::read(data.getData(), data.getSize());
+  });
+
+  return 0;
+}
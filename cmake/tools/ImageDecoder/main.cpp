@@ -0,0 +1,118 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "DecodedImage.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+// The size and the modification time of the image file, which are stored next to the
+// decoded image when decoding it
+juce::String getImageFileStamp(const juce::File& imageFile)
+{
+  return juce::String{imageFile.getSize()} + "\t"
+         + juce::String{imageFile.getLastModificationTime().toMilliseconds()};
+}
+
+
+juce::File getImageFileStampFile(const juce::File& decodedImageFile)
+{
+  return decodedImageFile.getSiblingFile(decodedImageFile.getFileName() + ".stamp");
+}
+
+} // namespace
+
+
+// Decodes PNG, JPEG and GIF images, so that BinaryDataBuilder can embed their pixels and
+// the generated code doesn't have to decode them at runtime (see DecodedImage.h)
+int main(int argc, char* argv[])
+{
+  if (argc < 3 || argc % 2 == 0)
+  {
+    std::cerr << "usage: ImageDecoder"
+              << " <image-file> <decoded-image-file>"
+              << " [<image-file> <decoded-image-file> ...]" << std::endl;
+    return 1;
+  }
+
+  const std::vector<std::string> args{argv, argv + argc};
+
+  for (auto i = size_t{1}; i + 1 < args.size(); i += 2)
+  {
+    const auto imageFile =
+      juce::File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(i)});
+    const auto decodedImageFile =
+      juce::File::getCurrentWorkingDirectory().getChildFile(juce::String{args.at(i + 1)});
+
+    if (!imageFile.existsAsFile())
+    {
+      std::cerr << "No such file: " << imageFile.getFullPathName() << std::endl;
+      return 1;
+    }
+
+    // Like the literals cached by BinaryDataBuilder, the images are only decoded again
+    // when their size or their modification time changed (even to an older time)
+    const auto imageFileStamp = getImageFileStamp(imageFile);
+    const auto imageFileStampFile = getImageFileStampFile(decodedImageFile);
+
+    if (decodedImageFile.existsAsFile() && imageFileStampFile.existsAsFile()
+        && imageFileStampFile.loadFileAsString() == imageFileStamp)
+    {
+      // The decoded image must not be older than the image file, otherwise the build
+      // system would run ImageDecoder again and again
+      if (decodedImageFile.getLastModificationTime()
+          < imageFile.getLastModificationTime())
+      {
+        decodedImageFile.setLastModificationTime(juce::Time::getCurrentTime());
+      }
+      continue;
+    }
+
+    const auto image = juce::ImageFileFormat::loadFrom(imageFile);
+    if (!image.isValid())
+    {
+      std::cerr << "Can't decode image file: " << imageFile.getFullPathName()
+                << std::endl;
+      return 1;
+    }
+
+    const auto decodedImage = DecodedImage::write(image);
+
+    if (!decodedImageFile.getParentDirectory().createDirectory()
+        || !decodedImageFile.replaceWithData(decodedImage.getData(),
+                                             decodedImage.getSize()))
+    {
+      std::cerr << "Can't write to file: " << decodedImageFile.getFullPathName()
+                << std::endl;
+      return 1;
+    }
+
+    if (!imageFileStampFile.replaceWithText(imageFileStamp))
+    {
+      std::cerr << "Can't write to file: " << imageFileStampFile.getFullPathName()
+                << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
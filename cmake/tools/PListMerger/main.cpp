@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2019  Alain Martin
+// Copyright (C) 2017-2019, 2026  Alain Martin
 //
 // This file is part of FRUT.
 //
@@ -17,43 +17,64 @@
 
 #include <juce_core/juce_core.h>
 
-#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 
-int main(int argc, char* argv[])
+namespace
+{
+
+// A plist argument is either the content of the plist, or "@" followed by the path of a
+// file containing the plist. The latter doesn't hit the command line length limits.
+bool readPlistArgument(const std::string& arg, juce::String& content)
 {
-  if (argc != 3)
+  if (arg.empty() || arg.front() != '@')
   {
-    std::cerr << "usage: PListMerger"
-              << " <first-plist-content>"
-              << " <second-plist-content>" << std::endl;
-    return 1;
+    content = juce::String{arg};
+    return true;
+  }
+
+  const auto file =
+    juce::File::getCurrentWorkingDirectory().getChildFile(juce::String{arg.substr(1)});
+  if (!file.existsAsFile())
+  {
+    std::cerr << "No such file: " << file.getFullPathName() << std::endl;
+    return false;
   }
 
-  const std::vector<std::string> args{argv, argv + argc};
+  content = file.loadFileAsString();
+  return true;
+}
+
 
-  const auto firstPlistElement =
-    std::unique_ptr<juce::XmlElement>{juce::XmlDocument::parse(args.at(1))};
-  if (!firstPlistElement || !firstPlistElement->hasTagName("plist"))
+std::unique_ptr<juce::XmlElement> parsePlist(const juce::String& content,
+                                             const std::string& name)
+{
+  auto plistElement =
+    std::unique_ptr<juce::XmlElement>{juce::XmlDocument::parse(content)};
+  if (!plistElement || !plistElement->hasTagName("plist"))
   {
-    std::cerr << "Invalid first plist content, expected <plist> element" << std::endl;
-    return 1;
+    std::cerr << "Invalid " << name << " content, expected <plist> element" << std::endl;
+    return nullptr;
   }
 
-  const auto firstDictElement = firstPlistElement->getChildByName("dict");
-  if (!firstDictElement)
+  if (!plistElement->getChildByName("dict"))
   {
-    std::cerr << "Invalid first plist content, expected <dict> element" << std::endl;
-    return 1;
+    std::cerr << "Invalid " << name << " content, expected <dict> element" << std::endl;
+    return nullptr;
   }
 
-  std::vector<std::string> keysInFirstPlist;
+  return plistElement;
+}
 
-  for (auto childElement = firstDictElement->getFirstChildElement();
+
+bool getKeysInFirstPlist(const juce::XmlElement& firstDictElement,
+                         std::unordered_set<std::string>& keysInFirstPlist)
+{
+  for (auto childElement = firstDictElement.getFirstChildElement();
        childElement != nullptr; childElement = childElement->getNextElement())
   {
     if (childElement->getTagName() != "key" || childElement->getNumChildElements() != 1
@@ -62,84 +83,220 @@ int main(int argc, char* argv[])
       std::cerr << "Invalid first plist content, expected <key> element with only one "
                    "text child element"
                 << std::endl;
-      return 1;
+      return false;
     }
 
     const auto key = childElement->getFirstChildElement()->getText().toStdString();
 
-    if (std::find(keysInFirstPlist.begin(), keysInFirstPlist.end(), key)
-        != keysInFirstPlist.end())
+    if (!keysInFirstPlist.insert(key).second)
     {
       std::cerr << "Invalid first plist content, duplicated key \"" << key << "\""
                 << std::endl;
-      return 1;
+      return false;
     }
 
-    keysInFirstPlist.push_back(key);
-
     childElement = childElement->getNextElement();
     if (childElement == nullptr)
     {
       std::cerr << "Invalid first plist content, missing value associated with key \""
                 << key << "\"" << std::endl;
-      return 1;
+      return false;
     }
   }
 
-  const auto secondPlistElement =
-    std::unique_ptr<juce::XmlElement>{juce::XmlDocument::parse(args.at(2))};
-  if (!secondPlistElement || !secondPlistElement->hasTagName("plist"))
-  {
-    std::cerr << "Invalid second plist content, expected <plist> element" << std::endl;
-    return 1;
-  }
+  return true;
+}
 
-  const auto secondDictElement = secondPlistElement->getChildByName("dict");
-  if (!secondDictElement)
-  {
-    std::cerr << "Invalid second plist content, expected <dict> element" << std::endl;
-    return 1;
-  }
 
-  for (auto childElement = secondDictElement->getFirstChildElement();
+// Appends the key-value pairs of secondDictElement whose key isn't in the first plist to
+// mergedDictElement, which is a copy of the <dict> element of the first plist
+bool mergeSecondPlist(const juce::XmlElement& secondDictElement,
+                      const std::string& name,
+                      const std::unordered_set<std::string>& keysInFirstPlist,
+                      juce::XmlElement& mergedDictElement)
+{
+  for (auto childElement = secondDictElement.getFirstChildElement();
        childElement != nullptr; childElement = childElement->getNextElement())
   {
     if (childElement->getTagName() != "key" || childElement->getNumChildElements() != 1
         || !childElement->getFirstChildElement()->isTextElement())
     {
-      std::cerr << "Invalid second plist content, expected <key> element with only one "
-                   "text child element"
+      std::cerr << "Invalid " << name
+                << " content, expected <key> element with only one text child element"
                 << std::endl;
-      return 1;
+      return false;
     }
 
     const auto key = childElement->getFirstChildElement()->getText().toStdString();
 
-    const auto isKeyAlreadyInFirstPlist =
-      std::find(keysInFirstPlist.begin(), keysInFirstPlist.end(), key)
-      != keysInFirstPlist.end();
+    const auto isKeyAlreadyInFirstPlist = keysInFirstPlist.count(key) != 0;
 
     if (!isKeyAlreadyInFirstPlist)
     {
-      firstDictElement->addChildElement(new juce::XmlElement(*childElement));
+      mergedDictElement.addChildElement(new juce::XmlElement(*childElement));
     }
 
     childElement = childElement->getNextElement();
     if (childElement == nullptr)
     {
-      std::cerr << "Invalid second plist content, missing value associated with key \""
+      std::cerr << "Invalid " << name << " content, missing value associated with key \""
                 << key << "\"" << std::endl;
-      return 1;
+      return false;
     }
 
     if (!isKeyAlreadyInFirstPlist)
     {
-      firstDictElement->addChildElement(new juce::XmlElement(*childElement));
+      mergedDictElement.addChildElement(new juce::XmlElement(*childElement));
+    }
+  }
+
+  return true;
+}
+
+
+bool writeOutputFile(const juce::File& outputFile, const juce::String& output)
+{
+  // Keep the timestamp of the output file when its content doesn't change
+  if (outputFile.existsAsFile() && outputFile.loadFileAsString() == output)
+  {
+    return true;
+  }
+
+  if (!outputFile.getParentDirectory().createDirectory().wasOk()
+      || !outputFile.replaceWithData(output.toRawUTF8(), output.getNumBytesAsUTF8()))
+  {
+    std::cerr << "Can't write to file: " << outputFile.getFullPathName() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+  const auto templateOption = std::string{"--template="};
+  const auto outputOption = std::string{"--output="};
+
+  std::vector<std::string> args;
+  auto templateFile = juce::File{};
+  std::vector<juce::File> outputFiles;
+
+  for (auto i = 1; i < argc; ++i)
+  {
+    const auto arg = std::string{argv[i]};
+
+    if (arg.compare(0, templateOption.length(), templateOption) == 0)
+    {
+      templateFile = juce::File::getCurrentWorkingDirectory().getChildFile(
+        juce::String{arg.substr(templateOption.length())});
+    }
+    else if (arg.compare(0, outputOption.length(), outputOption) == 0)
+    {
+      outputFiles.push_back(juce::File::getCurrentWorkingDirectory().getChildFile(
+        juce::String{arg.substr(outputOption.length())}));
+    }
+    else
+    {
+      args.push_back(arg);
+    }
+  }
+
+  // Each second plist is merged into the first plist separately. The merged plists are
+  // written to the output files in the same order, or to stdout when there is only one
+  // second plist and no output file.
+  const auto numSecondPlists = args.size() < 2 ? 0 : args.size() - 1;
+
+  if (numSecondPlists == 0
+      || (outputFiles.empty() ? numSecondPlists != 1
+                              : outputFiles.size() != numSecondPlists))
+  {
+    std::cerr << "usage: PListMerger"
+              << " [--template=<plist-template-file>]"
+              << " <first-plist-content | @first-plist-file>"
+              << " <second-plist-content | @second-plist-file>..."
+              << " [--output=<output-file>...]" << std::endl;
+    return 1;
+  }
+
+  juce::String firstPlistContent;
+  if (!readPlistArgument(args.at(0), firstPlistContent))
+  {
+    return 1;
+  }
+
+  const auto firstPlistElement = parsePlist(firstPlistContent, "first plist");
+  if (!firstPlistElement)
+  {
+    return 1;
+  }
+
+  std::unordered_set<std::string> keysInFirstPlist;
+  if (!getKeysInFirstPlist(*firstPlistElement->getChildByName("dict"), keysInFirstPlist))
+  {
+    return 1;
+  }
+
+  juce::String templateContent;
+  if (templateFile != juce::File{})
+  {
+    if (!templateFile.existsAsFile())
+    {
+      std::cerr << "No such file: " << templateFile.getFullPathName() << std::endl;
+      return 1;
     }
+
+    templateContent = templateFile.loadFileAsString();
   }
 
-  std::cout << firstPlistElement->createDocument(juce::String{}, false, false)
-            << std::flush;
+  for (auto i = 0u; i < numSecondPlists; ++i)
+  {
+    const auto name = numSecondPlists > 1 ? "second plist #" + std::to_string(i + 1)
+                                          : std::string{"second plist"};
+
+    juce::String secondPlistContent;
+    if (!readPlistArgument(args.at(i + 1), secondPlistContent))
+    {
+      return 1;
+    }
+
+    const auto secondPlistElement = parsePlist(secondPlistContent, name);
+    if (!secondPlistElement)
+    {
+      return 1;
+    }
+
+    juce::XmlElement mergedPlistElement{*firstPlistElement};
+    if (!mergeSecondPlist(*secondPlistElement->getChildByName("dict"), name,
+                          keysInFirstPlist, *mergedPlistElement.getChildByName("dict")))
+    {
+      return 1;
+    }
+
+    auto output = mergedPlistElement.createDocument(juce::String{}, false, false)
+                    .replace("\r\n", "\n")
+                    .trimEnd();
+
+    if (templateFile != juce::File{})
+    {
+      // Only the entries of the merged <dict> element replace @plist_entries@, since the
+      // template already contains the <plist> and <dict> elements
+      const auto plistEntries =
+        output.replace("<plist>\n  <dict>", "").replace("\n  </dict>\n</plist>", "");
+      output = templateContent.replace("@plist_entries@", plistEntries);
+    }
+
+    if (outputFiles.empty())
+    {
+      std::cout << output << std::flush;
+    }
+    else if (!writeOutputFile(outputFiles.at(i), output))
+    {
+      return 1;
+    }
+  }
 
   return 0;
 }
@@ -1,4 +1,4 @@
-# Copyright (C) 2017-2020, 2022-2023  Alain Martin
+# Copyright (C) 2017-2020, 2022-2023, 2026  Alain Martin
 #
 # This file is part of FRUT.
 #
@@ -15,15 +15,18 @@
 # You should have received a copy of the GNU General Public License
 # along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
 
-add_library(tools_juce_core STATIC "")
-
-if(APPLE)
-  target_sources(tools_juce_core PRIVATE "${JUCE_modules_DIR}/juce_core/juce_core.mm")
-else()
-  target_sources(tools_juce_core PRIVATE "${JUCE_modules_DIR}/juce_core/juce_core.cpp")
+if(TARGET tools_juce_core)
+  return()
 endif()
 
-target_include_directories(tools_juce_core PUBLIC "${JUCE_modules_DIR}")
+include("${CMAKE_CURRENT_LIST_DIR}/juce_library.cmake")
+
+
+add_tools_juce_library(tools_juce_core
+  MODULES juce_core
+  APPLE_FRAMEWORKS Cocoa Foundation IOKit Security
+  MINGW_LIBRARIES -lshlwapi -lversion -lwininet -lwinmm -lws2_32
+)
 
 target_compile_definitions(tools_juce_core PUBLIC
   $<$<CONFIG:Debug>:DEBUG=1>
@@ -31,36 +34,11 @@ target_compile_definitions(tools_juce_core PUBLIC
   $<$<NOT:$<CONFIG:Debug>>:NDEBUG=1>
   JUCE_DISABLE_JUCE_VERSION_PRINTING=1
   JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED=1
-  JUCE_MODULE_AVAILABLE_juce_core=1
   JUCE_STANDALONE_APPLICATION=1
   JUCE_USE_CURL=0
 )
 
-if(APPLE)
-  target_compile_options(tools_juce_core PRIVATE
-    -Wno-deprecated-declarations
-    -Wno-register
-  )
-
-  find_library(Cocoa_framework "Cocoa")
-  find_library(Foundation_framework "Foundation")
-  find_library(IOKit_framework "IOKit")
-  find_library(Security_framework "Security")
-
-  target_link_libraries(tools_juce_core PUBLIC
-    ${Cocoa_framework} ${Foundation_framework} ${IOKit_framework} ${Security_framework}
-  )
-endif()
-
 if(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
   target_compile_options(tools_juce_core PUBLIC -pthread)
   target_link_libraries(tools_juce_core PUBLIC dl pthread)
 endif()
-
-if(WIN32 AND NOT MSVC)
-  target_compile_options(tools_juce_core PRIVATE -Wno-cpp)
-
-  target_link_libraries(tools_juce_core PUBLIC
-    -lshlwapi -lversion -lwininet -lwinmm -lws2_32
-  )
-endif()
@@ -0,0 +1,51 @@
+# Copyright (C) 2026  Alain Martin
+#
+# This file is part of FRUT.
+#
+# FRUT is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FRUT is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+if(TARGET tools_juce_graphics)
+  return()
+endif()
+
+include("${CMAKE_CURRENT_LIST_DIR}/juce_core.cmake")
+
+
+# Before JUCE 5, the message loop of juce_events talks to the X server on Linux. Later
+# versions don't need X11 outside of juce_gui_basics.
+file(GLOB juce_events_linux_sources
+  "${JUCE_modules_DIR}/juce_events/juce_events.cpp"
+  "${JUCE_modules_DIR}/juce_events/native/juce_linux_*.cpp"
+)
+set(juce_events_linux_packages "")
+foreach(source_file IN LISTS juce_events_linux_sources)
+  file(STRINGS "${source_file}" x11_includes REGEX "#include <X11/")
+  if(x11_includes)
+    set(juce_events_linux_packages "x11")
+  endif()
+endforeach()
+
+add_tools_juce_library(tools_juce_events
+  MODULES juce_events
+  LINK_LIBRARIES tools_juce_core
+  LINUX_PACKAGES ${juce_events_linux_packages}
+)
+
+# juce_graphics needs juce_events (the image cache is a Timer), but not X11
+add_tools_juce_library(tools_juce_graphics
+  MODULES juce_graphics
+  LINK_LIBRARIES tools_juce_events
+  APPLE_FRAMEWORKS QuartzCore
+  LINUX_PACKAGES freetype2
+)
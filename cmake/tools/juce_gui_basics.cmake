@@ -1,4 +1,4 @@
-# Copyright (C) 2017-2023  Alain Martin
+# Copyright (C) 2017-2023, 2026  Alain Martin
 # Copyright (C) 2019  David Holland
 #
 # This file is part of FRUT.
@@ -16,97 +16,23 @@
 # You should have received a copy of the GNU General Public License
 # along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
 
-add_library(tools_juce_gui_basics STATIC "")
-
-if(APPLE)
-  target_sources(tools_juce_gui_basics PRIVATE
-    "${JUCE_modules_DIR}/juce_core/juce_core.mm"
-    "${JUCE_modules_DIR}/juce_data_structures/juce_data_structures.mm"
-    "${JUCE_modules_DIR}/juce_events/juce_events.mm"
-    "${JUCE_modules_DIR}/juce_graphics/juce_graphics.mm"
-    "${JUCE_modules_DIR}/juce_gui_basics/juce_gui_basics.mm"
-  )
-else()
-  target_sources(tools_juce_gui_basics PRIVATE
-    "${JUCE_modules_DIR}/juce_core/juce_core.cpp"
-    "${JUCE_modules_DIR}/juce_data_structures/juce_data_structures.cpp"
-    "${JUCE_modules_DIR}/juce_events/juce_events.cpp"
-    "${JUCE_modules_DIR}/juce_graphics/juce_graphics.cpp"
-    "${JUCE_modules_DIR}/juce_gui_basics/juce_gui_basics.cpp"
-  )
+if(TARGET tools_juce_gui_basics)
+  return()
 endif()
 
-target_include_directories(tools_juce_gui_basics PUBLIC "${JUCE_modules_DIR}")
+include("${CMAKE_CURRENT_LIST_DIR}/juce_graphics.cmake")
+
 
-target_compile_definitions(tools_juce_gui_basics PUBLIC
-  $<$<CONFIG:Debug>:DEBUG=1>
-  $<$<CONFIG:Debug>:_DEBUG=1>
-  $<$<NOT:$<CONFIG:Debug>>:NDEBUG=1>
-  JUCE_DISABLE_JUCE_VERSION_PRINTING=1
-  JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED=1
-  JUCE_MODULE_AVAILABLE_juce_core=1
-  JUCE_MODULE_AVAILABLE_juce_data_structures=1
-  JUCE_MODULE_AVAILABLE_juce_events=1
-  JUCE_MODULE_AVAILABLE_juce_graphics=1
-  JUCE_MODULE_AVAILABLE_juce_gui_basics=1
-  JUCE_STANDALONE_APPLICATION=1
-  JUCE_USE_CURL=0
+add_tools_juce_library(tools_juce_gui_basics
+  MODULES juce_data_structures juce_gui_basics
+  LINK_LIBRARIES tools_juce_graphics
+  LINUX_PACKAGES x11 xext
+  MINGW_LIBRARIES -limm32
 )
 
 if(APPLE)
-  target_compile_options(tools_juce_gui_basics PRIVATE
-    -Wno-deprecated-declarations
-    -Wno-register
-  )
-
-  find_library(Cocoa_framework "Cocoa")
-  find_library(Foundation_framework "Foundation")
-  find_library(IOKit_framework "IOKit")
-  find_library(QuartzCore_framework "QuartzCore")
-  find_library(Security_framework "Security")
-
-  target_link_libraries(tools_juce_gui_basics PUBLIC
-    ${Cocoa_framework}
-    ${Foundation_framework}
-    ${IOKit_framework}
-    ${QuartzCore_framework}
-    ${Security_framework}
-  )
   target_link_libraries(tools_juce_gui_basics PUBLIC
     "-weak_framework Metal"
     "-weak_framework MetalKit"
   )
 endif()
-
-if(MSVC)
-  target_compile_options(tools_juce_gui_basics PRIVATE /bigobj)
-endif()
-
-if(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
-  find_package(PkgConfig REQUIRED)
-
-  function(use_package package)
-    pkg_check_modules(${package} "${package}")
-    if(NOT ${package}_FOUND)
-      message(FATAL_ERROR "pkg-config could not find ${package}")
-    endif()
-    target_compile_options(tools_juce_gui_basics PUBLIC ${${package}_CFLAGS})
-    target_link_libraries(tools_juce_gui_basics PUBLIC ${${package}_LIBRARIES})
-  endfunction()
-
-  use_package(freetype2)
-  use_package(x11)
-  use_package(xext)
-
-  target_compile_options(tools_juce_gui_basics PUBLIC -pthread)
-  target_link_libraries(tools_juce_gui_basics PUBLIC dl pthread)
-endif()
-
-if(WIN32 AND NOT MSVC)
-  target_compile_options(tools_juce_gui_basics PRIVATE -Wno-cpp -Wno-multichar)
-
-  target_compile_options(tools_juce_gui_basics PUBLIC "-Wa,-mbig-obj")
-  target_link_libraries(tools_juce_gui_basics PUBLIC
-    -limm32 -lshlwapi -lversion -lwininet -lwinmm -lws2_32
-  )
-endif()
@@ -0,0 +1,97 @@
+# Copyright (C) 2017-2023, 2026  Alain Martin
+# Copyright (C) 2019  David Holland
+#
+# This file is part of FRUT.
+#
+# FRUT is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# FRUT is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+include(CMakeParseArguments)
+
+
+# add_tools_juce_library(<library>
+#   MODULES <module>...
+#   [LINK_LIBRARIES <library>...]
+#   [APPLE_FRAMEWORKS <framework>...]
+#   [LINUX_PACKAGES <package>...]
+#   [MINGW_LIBRARIES <library>...]
+# )
+#
+# Adds a static library that compiles the given JUCE modules only. The modules they depend
+# on come from LINK_LIBRARIES, so that the tools share the libraries of the modules they
+# have in common, and only link the platform libraries of the modules they use.
+function(add_tools_juce_library library)
+
+  set(multi_value_keywords
+    "MODULES" "LINK_LIBRARIES" "APPLE_FRAMEWORKS" "LINUX_PACKAGES" "MINGW_LIBRARIES"
+  )
+  cmake_parse_arguments(arg "" "" "${multi_value_keywords}" ${ARGN})
+
+  add_library(${library} STATIC "")
+
+  foreach(module_name IN LISTS arg_MODULES)
+    if(APPLE)
+      target_sources(${library} PRIVATE
+        "${JUCE_modules_DIR}/${module_name}/${module_name}.mm"
+      )
+    else()
+      target_sources(${library} PRIVATE
+        "${JUCE_modules_DIR}/${module_name}/${module_name}.cpp"
+      )
+    endif()
+    target_compile_definitions(${library} PUBLIC
+      JUCE_MODULE_AVAILABLE_${module_name}=1
+    )
+  endforeach()
+
+  target_include_directories(${library} PUBLIC "${JUCE_modules_DIR}")
+
+  target_link_libraries(${library} PUBLIC ${arg_LINK_LIBRARIES})
+
+  if(APPLE)
+    target_compile_options(${library} PRIVATE
+      -Wno-deprecated-declarations
+      -Wno-register
+    )
+
+    foreach(framework IN LISTS arg_APPLE_FRAMEWORKS)
+      find_library(${framework}_framework "${framework}")
+      target_link_libraries(${library} PUBLIC ${${framework}_framework})
+    endforeach()
+  endif()
+
+  if(MSVC)
+    target_compile_options(${library} PRIVATE /bigobj)
+  endif()
+
+  if(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux" AND arg_LINUX_PACKAGES)
+    find_package(PkgConfig REQUIRED)
+
+    foreach(package IN LISTS arg_LINUX_PACKAGES)
+      pkg_check_modules(${package} "${package}")
+      if(NOT ${package}_FOUND)
+        message(FATAL_ERROR "pkg-config could not find ${package}")
+      endif()
+      target_compile_options(${library} PUBLIC ${${package}_CFLAGS})
+      target_link_libraries(${library} PUBLIC ${${package}_LIBRARIES})
+    endforeach()
+  endif()
+
+  if(WIN32 AND NOT MSVC)
+    target_compile_options(${library} PRIVATE -Wno-cpp -Wno-multichar)
+
+    target_compile_options(${library} PUBLIC "-Wa,-mbig-obj")
+    target_link_libraries(${library} PUBLIC ${arg_MINGW_LIBRARIES})
+  endif()
+
+endfunction()
@@ -0,0 +1,121 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BinaryData.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+// The data must be the content of the resource file, followed by a null byte
+bool hasContentOf(const char* data, int dataSize, const std::string& originalFilename)
+{
+  auto file = std::ifstream{std::string{RESOURCES_DIR} + "/" + originalFilename,
+                            std::ios::binary};
+  const auto expected = std::vector<char>{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+
+  return data != nullptr && dataSize == static_cast<int>(expected.size())
+         && std::memcmp(data, expected.data(), expected.size()) == 0
+         && data[dataSize] == '\0';
+}
+
+
+void test_resource_alignment_constant()
+{
+  static_assert(BinaryData::resourceAlignment == 64,
+                "resourceAlignment is JUCER_BINARYDATA_ALIGNMENT");
+}
+
+
+void test_resources_are_aligned()
+{
+  for (auto i = 0; i < BinaryData::namedResourceListSize; ++i)
+  {
+    const auto originalFilename = std::string{BinaryData::originalFilenames[i]};
+
+    auto dataSize = -1;
+    const auto data =
+      BinaryData::getNamedResource(BinaryData::namedResourceList[i], dataSize);
+    check(hasContentOf(data, dataSize, originalFilename),
+          "getNamedResource() returns the content of " + originalFilename);
+    check(reinterpret_cast<std::uintptr_t>(data) % BinaryData::resourceAlignment == 0,
+          originalFilename + " is aligned");
+  }
+}
+
+
+// The data is padded with null bytes up to the next multiple of the alignment, after its
+// own null byte
+void test_resources_are_padded_with_null_bytes()
+{
+  for (auto i = 0; i < BinaryData::namedResourceListSize; ++i)
+  {
+    const auto originalFilename = std::string{BinaryData::originalFilenames[i]};
+
+    auto dataSize = 0;
+    const auto data =
+      BinaryData::getNamedResource(BinaryData::namedResourceList[i], dataSize);
+    if (data == nullptr)
+    {
+      continue;
+    }
+
+    const auto paddedSize = (dataSize + BinaryData::resourceAlignment)
+                            / BinaryData::resourceAlignment
+                            * BinaryData::resourceAlignment;
+    auto isPaddedWithNullBytes = true;
+    for (auto j = dataSize; j < paddedSize; ++j)
+    {
+      isPaddedWithNullBytes = isPaddedWithNullBytes && data[j] == '\0';
+    }
+    check(isPaddedWithNullBytes, originalFilename + " is padded with null bytes");
+  }
+}
+
+} // namespace
+
+
+int main()
+{
+  test_resource_alignment_constant();
+  test_resources_are_aligned();
+  test_resources_are_padded_with_null_bytes();
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "JuceHeader.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+// The data must be the content of the resource file, followed by a null byte
+bool hasContentOf(const char* data, int dataSize, const std::string& originalFilename)
+{
+  auto file = std::ifstream{std::string{RESOURCES_DIR} + "/" + originalFilename,
+                            std::ios::binary};
+  const auto expected = std::vector<char>{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+
+  return data != nullptr && dataSize == static_cast<int>(expected.size())
+         && std::memcmp(data, expected.data(), expected.size()) == 0
+         && data[dataSize] == '\0';
+}
+
+
+void test_compressed_resource()
+{
+  check(BinaryData::text_txtCompressedSize < BinaryData::text_txtSize,
+        "text.txt is smaller once compressed");
+  check(BinaryData::getNamedResourceCompressedSize("text_txt")
+          == BinaryData::text_txtCompressedSize,
+        "getNamedResourceCompressedSize() returns the compressed size of text.txt");
+
+  auto dataSize = -1;
+  const auto data = BinaryData::getUncompressedNamedResource("text_txt", dataSize);
+  check(hasContentOf(data, dataSize, "text.txt"),
+        "getUncompressedNamedResource() returns the content of text.txt");
+
+  dataSize = -1;
+  check(BinaryData::getNamedResource("text_txt", dataSize) == nullptr && dataSize == 0,
+        "getNamedResource() returns a null pointer for compressed resources");
+}
+
+
+// The bytes of bytes.bin don't compress, so they are embedded as is
+void test_uncompressed_resource()
+{
+  check(BinaryData::getNamedResourceCompressedSize("bytes_bin") == 0,
+        "bytes.bin isn't compressed");
+
+  auto dataSize = -1;
+  const auto data = BinaryData::getNamedResource("bytes_bin", dataSize);
+  check(hasContentOf(data, dataSize, "bytes.bin"),
+        "getNamedResource() returns the content of bytes.bin");
+
+  auto uncompressedDataSize = -1;
+  check(BinaryData::getUncompressedNamedResource("bytes_bin", uncompressedDataSize) == data
+          && uncompressedDataSize == dataSize,
+        "getUncompressedNamedResource() returns the data of uncompressed resources");
+}
+
+
+void test_resource_is_decompressed_once()
+{
+  auto firstSize = 0;
+  auto secondSize = 0;
+  check(BinaryData::getUncompressedNamedResource("text_txt", firstSize)
+          == BinaryData::getUncompressedNamedResource("text_txt", secondSize),
+        "text.txt is only decompressed once");
+}
+
+
+void test_unknown_resource()
+{
+  auto dataSize = -1;
+  check(BinaryData::getUncompressedNamedResource("unknown", dataSize) == nullptr
+          && dataSize == 0,
+        "getUncompressedNamedResource() with an unknown name");
+  check(BinaryData::getNamedResourceCompressedSize("unknown") == 0,
+        "getNamedResourceCompressedSize() with an unknown name");
+}
+
+} // namespace
+
+
+int main()
+{
+  test_compressed_resource();
+  test_resource_is_decompressed_once();
+  test_uncompressed_resource();
+  test_unknown_resource();
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BinaryData.h"
+
+#include <iostream>
+#include <iterator>
+#include <string>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+void test_resource_info_is_resolved_at_compile_time()
+{
+  constexpr auto& info = BinaryData::getResourceInfo("text_txt");
+  static_assert(info.name == "text_txt", "name of text.txt");
+  static_assert(info.originalFilename == "text.txt", "original filename of text.txt");
+  static_assert(info.size == BinaryData::text_txtSize, "size of text.txt");
+  static_assert(info.data == &BinaryData::text_txt, "data of text.txt");
+
+  // xxHash64 of no bytes
+  static_assert(BinaryData::getResourceInfo("empty_bin").contentHash
+                  == 0xef46db3751d8e999ull,
+                "content hash of empty.bin");
+}
+
+
+void test_resource_index_matches_named_resources()
+{
+  static_assert(std::size(BinaryData::resourceIndex) == BinaryData::namedResourceListSize,
+                "resourceIndex has an element per resource");
+
+  for (const auto& info : BinaryData::resourceIndex)
+  {
+    const auto name = std::string{info.name};
+
+    auto dataSize = -1;
+    check(BinaryData::getNamedResource(name.c_str(), dataSize) == *info.data
+            && dataSize == info.size,
+          "resourceIndex has the data of " + name);
+    check(BinaryData::getNamedResourceOriginalFilename(name.c_str())
+            == std::string{info.originalFilename},
+          "resourceIndex has the original filename of " + name);
+  }
+}
+
+
+void test_unknown_resource()
+{
+  const auto& info = BinaryData::getResourceInfo("unknown");
+  check(info.name.empty() && info.size == 0 && info.contentHash == 0
+          && info.data == nullptr,
+        "getResourceInfo() with an unknown name");
+}
+
+} // namespace
+
+
+int main()
+{
+  test_resource_index_matches_named_resources();
+  test_resource_info_is_resolved_at_compile_time();
+  test_unknown_resource();
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BinaryData.h"
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+void test_content_hash_is_xxhash64()
+{
+  // xxHash64 of no bytes
+  check(BinaryData::empty_binContentHash == 0xef46db3751d8e999ull,
+        "content hash of empty.bin");
+}
+
+
+void test_content_hashes_only_depend_on_the_content()
+{
+  check(BinaryData::text_txtContentHash == BinaryData::text_copy_txtContentHash,
+        "text.txt and text_copy.txt have the same content hash");
+  check(BinaryData::text_txtContentHash != BinaryData::bytes_binContentHash,
+        "text.txt and bytes.bin have different content hashes");
+  check(BinaryData::allResourcesContentHash != 0, "allResourcesContentHash isn't 0");
+}
+
+
+void test_named_resource_content_hash()
+{
+  for (const auto& resource :
+       {std::make_pair("bytes_bin", BinaryData::bytes_binContentHash),
+        std::make_pair("empty_bin", BinaryData::empty_binContentHash),
+        std::make_pair("text_txt", BinaryData::text_txtContentHash),
+        std::make_pair("text_copy_txt", BinaryData::text_copy_txtContentHash)})
+  {
+    check(BinaryData::getNamedResourceContentHash(resource.first) == resource.second,
+          std::string{"getNamedResourceContentHash() returns the content hash of "}
+            + resource.first);
+  }
+
+  check(BinaryData::getNamedResourceContentHash("unknown") == 0,
+        "getNamedResourceContentHash() with an unknown name");
+}
+
+} // namespace
+
+
+int main()
+{
+  test_content_hash_is_xxhash64();
+  test_content_hashes_only_depend_on_the_content();
+  test_named_resource_content_hash();
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "JuceHeader.h"
+
+#include <iostream>
+#include <string>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+bool haveSamePixels(const juce::Image& image, const juce::Image& expected)
+{
+  if (image.getWidth() != expected.getWidth()
+      || image.getHeight() != expected.getHeight())
+  {
+    return false;
+  }
+
+  for (auto y = 0; y < expected.getHeight(); ++y)
+  {
+    for (auto x = 0; x < expected.getWidth(); ++x)
+    {
+      if (image.getPixelAt(x, y) != expected.getPixelAt(x, y))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+void test_decoded_image()
+{
+  const auto image = BinaryData::getDecodedImage("image_png");
+  check(image.isValid() && image.getFormat() == juce::Image::ARGB,
+        "getDecodedImage() returns an ARGB image for image.png");
+
+  const auto expected =
+    juce::ImageFileFormat::loadFrom(juce::File{RESOURCES_DIR}.getChildFile("image.png"))
+      .convertedToFormat(juce::Image::ARGB);
+  check(expected.isValid() && haveSamePixels(image, expected),
+        "getDecodedImage() returns the pixels of image.png");
+}
+
+
+void test_decoded_image_can_be_modified()
+{
+  auto image = BinaryData::getDecodedImage("image_png");
+  image.setPixelAt(0, 0, juce::Colours::transparentBlack);
+
+  check(BinaryData::getDecodedImage("image_png").getPixelAt(0, 0)
+          != juce::Colours::transparentBlack,
+        "modifying a decoded image doesn't modify the binary resource");
+}
+
+
+void test_not_a_decoded_image()
+{
+  check(BinaryData::getDecodedImage("text_txt").isNull(),
+        "getDecodedImage() returns a null image for text.txt");
+  check(BinaryData::getDecodedImage("unknown").isNull(),
+        "getDecodedImage() with an unknown name");
+}
+
+} // namespace
+
+
+int main()
+{
+  test_decoded_image();
+  test_decoded_image_can_be_modified();
+  test_not_a_decoded_image();
+
+  return failures == 0 ? 0 : 1;
+}
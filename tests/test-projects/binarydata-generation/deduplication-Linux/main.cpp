@@ -0,0 +1,98 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BinaryData.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+// The data must be the content of the resource file, followed by a null byte
+bool hasContentOf(const char* data, int dataSize, const std::string& originalFilename)
+{
+  auto file = std::ifstream{std::string{RESOURCES_DIR} + "/" + originalFilename,
+                            std::ios::binary};
+  const auto expected = std::vector<char>{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+
+  return data != nullptr && dataSize == static_cast<int>(expected.size())
+         && std::memcmp(data, expected.data(), expected.size()) == 0
+         && data[dataSize] == '\0';
+}
+
+
+void test_duplicates_share_their_data()
+{
+  check(BinaryData::text_txt == BinaryData::text_copy_txt,
+        "text.txt and text_copy.txt share their data");
+  check(BinaryData::text_txtSize == BinaryData::text_copy_txtSize,
+        "text.txt and text_copy.txt have the same size");
+}
+
+
+void test_different_resources_dont_share_their_data()
+{
+  check(BinaryData::text_txt != BinaryData::bytes_bin,
+        "text.txt and bytes.bin don't share their data");
+}
+
+
+void test_duplicates_are_named_resources()
+{
+  for (const auto& resource : {std::make_pair("text_txt", "text.txt"),
+                               std::make_pair("text_copy_txt", "text_copy.txt"),
+                               std::make_pair("bytes_bin", "bytes.bin")})
+  {
+    auto dataSize = -1;
+    const auto data = BinaryData::getNamedResource(resource.first, dataSize);
+    check(hasContentOf(data, dataSize, resource.second),
+          std::string{"getNamedResource() returns the content of "} + resource.second);
+  }
+}
+
+} // namespace
+
+
+int main()
+{
+  test_different_resources_dont_share_their_data();
+  test_duplicates_are_named_resources();
+  test_duplicates_share_their_data();
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "BinaryData.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+int main()
+{
+  auto failures = 0;
+
+  for (auto i = 0; i < BinaryData::namedResourceListSize; ++i)
+  {
+    const auto resourceName = BinaryData::namedResourceList[i];
+    const auto originalFilename = BinaryData::originalFilenames[i];
+
+    auto file = std::ifstream{std::string{RESOURCES_DIR} + "/" + originalFilename,
+                              std::ios::binary};
+    const auto expected = std::vector<char>{std::istreambuf_iterator<char>{file},
+                                            std::istreambuf_iterator<char>{}};
+
+    auto dataSize = 0;
+    const auto data = BinaryData::getNamedResource(resourceName, dataSize);
+
+    if (data == nullptr || dataSize != static_cast<int>(expected.size())
+        || std::memcmp(data, expected.data(), expected.size()) != 0
+        || data[dataSize] != '\0')
+    {
+      std::cerr << "Mismatch for " << originalFilename << std::endl;
+      ++failures;
+    }
+  }
+
+  return failures == 0 ? 0 : 1;
+}
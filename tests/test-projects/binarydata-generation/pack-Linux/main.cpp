@@ -0,0 +1,111 @@
+// Copyright (C) 2026  Alain Martin
+//
+// This file is part of FRUT.
+//
+// FRUT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// FRUT is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with FRUT.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "JuceHeader.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+auto failures = 0;
+
+
+void check(bool condition, const std::string& description)
+{
+  if (!condition)
+  {
+    std::cerr << "Check failed: " << description << std::endl;
+    ++failures;
+  }
+}
+
+
+// The data must be the content of the resource file, followed by a null byte
+bool hasContentOf(const char* data, int dataSize, const std::string& originalFilename)
+{
+  auto file = std::ifstream{std::string{RESOURCES_DIR} + "/" + originalFilename,
+                            std::ios::binary};
+  const auto expected = std::vector<char>{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+
+  return data != nullptr && dataSize == static_cast<int>(expected.size())
+         && std::memcmp(data, expected.data(), expected.size()) == 0
+         && data[dataSize] == '\0';
+}
+
+
+void test_resources_are_mapped_from_the_pack_file()
+{
+  for (auto i = 0; i < BinaryData::namedResourceListSize; ++i)
+  {
+    const auto originalFilename = std::string{BinaryData::originalFilenames[i]};
+
+    auto dataSize = -1;
+    const auto data =
+      BinaryData::getNamedResource(BinaryData::namedResourceList[i], dataSize);
+    check(hasContentOf(data, dataSize, originalFilename),
+          "getNamedResource() returns the content of " + originalFilename);
+  }
+
+  auto dataSize = -1;
+  check(BinaryData::text_txt() != nullptr
+          && BinaryData::text_txt() == BinaryData::getNamedResource("text_txt", dataSize),
+        "text_txt() returns the same data as getNamedResource()");
+}
+
+
+// Run from a directory without BinaryData.pack
+void test_missing_pack_file()
+{
+  check(BinaryData::text_txt() == nullptr, "text_txt() without the pack file");
+
+  for (auto i = 0; i < BinaryData::namedResourceListSize; ++i)
+  {
+    const auto originalFilename = std::string{BinaryData::originalFilenames[i]};
+
+    auto dataSize = -1;
+    const auto data =
+      BinaryData::getNamedResource(BinaryData::namedResourceList[i], dataSize);
+    check(data == nullptr && dataSize == 0,
+          "getNamedResource() returns no data for " + originalFilename
+            + " without the pack file");
+  }
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+  if (argc == 2 && std::string{argv[1]} == "--without-pack-file")
+  {
+    test_missing_pack_file();
+  }
+  else
+  {
+    test_resources_are_mapped_from_the_pack_file();
+  }
+
+  return failures == 0 ? 0 : 1;
+}